@@ -0,0 +1,148 @@
+#pragma once
+
+#include "AbilityAllocationTransaction.h"
+
+/**
+ * Undoable point allocation on top of an FAbility, for talent screens that let players
+ * experiment before confirming.
+ *
+ * Every click is one step in a journal of deltas; the FAbility itself is never copied or
+ * touched. Projected values come from an FAbilityAllocationTransaction overlay, so reading the
+ * would-be state, undoing and redoing each cost one staged-module update. A new step after an
+ * undo discards the redo tail.
+ *
+ * Confirming applies the net result as a single batch. For a component's progression use
+ * UAbilityComponent::CommitAllocation, which applies it on the authority or sends it as one RPC
+ * from a client; Commit applies it to a standalone FAbility directly.
+ *
+ * On a client the FAbility is overwritten by replication while the screen is open. Bind Revalidate
+ * to UAbilityComponent::OnProgressionReplaced: the session survives if its steps still fit the new
+ * state and is cleared otherwise. Undo and Redo re-check the step and fail instead of applying it
+ * when the underlying points no longer allow it.
+ */
+class FAbilityAllocationSession
+{
+public:
+    explicit FAbilityAllocationSession(FAbility& InAbility)
+        : Transaction(InAbility)
+    {
+    }
+
+    // Adds one step. Returns false and records nothing if the projected state would become invalid.
+    bool Allocate(EAbilityCategory Category, uint8 Type, int8 Delta)
+    {
+        if (Delta == 0 || !Transaction.Allocate(Category, Type, Delta))
+        {
+            return false;
+        }
+
+        Steps.SetNum(Cursor, EAllowShrinking::No);
+        FAbilityAllocationDelta& Step = Steps.AddDefaulted_GetRef();
+        Step.Category = Category;
+        Step.Type = Type;
+        Step.Delta = Delta;
+        ++Cursor;
+        return true;
+    }
+
+    // Reverts the last step. Returns false if there is nothing to undo or the FAbility changed so that reverting it is no longer valid.
+    bool Undo()
+    {
+        if (!CanUndo())
+        {
+            return false;
+        }
+
+        const FAbilityAllocationDelta& Step = Steps[Cursor - 1];
+        if (!Transaction.Allocate(Step.Category, Step.Type, static_cast<int8>(-Step.Delta)))
+        {
+            return false;
+        }
+        --Cursor;
+        return true;
+    }
+
+    // Reapplies the last undone step. Returns false if there is nothing to redo or the step no longer fits.
+    bool Redo()
+    {
+        if (!CanRedo())
+        {
+            return false;
+        }
+
+        const FAbilityAllocationDelta& Step = Steps[Cursor];
+        if (!Transaction.Allocate(Step.Category, Step.Type, Step.Delta))
+        {
+            return false;
+        }
+        ++Cursor;
+        return true;
+    }
+
+    /*
+     * Re-checks the session after the FAbility was replaced, e.g. by replication. If the applied
+     * steps no longer fit, the session is cleared. Returns true if the session is still intact.
+     */
+    bool Revalidate()
+    {
+        if (!Transaction.Revalidate())
+        {
+            Reset();
+            return false;
+        }
+        return true;
+    }
+
+    bool CanUndo() const { return Cursor > 0; }
+
+    bool CanRedo() const { return Cursor < Steps.Num(); }
+
+    // Projected allocated points of a module.
+    int32 GetAllocatedPoint(EAbilityCategory Category, uint8 Type) const { return Transaction.GetAllocatedPoint(Category, Type); }
+
+    // Projected pool points still free to allocate.
+    int32 GetAvailablePoints() const { return Transaction.GetAvailablePoints(); }
+
+    // Returns true if the session would change nothing.
+    bool IsEmpty() const { return Transaction.IsEmpty(); }
+
+    // Net change of the session as one delta per module, ready for AllocateAbilityPoints.
+    template<typename AllocatorType>
+    void GetDeltas(TArray<FAbilityAllocationDelta, AllocatorType>& OutDeltas) const
+    {
+        Transaction.GetDeltas(OutDeltas);
+    }
+
+    // Applies the net change to a standalone FAbility as one batch and clears the session. Returns false if it was rejected.
+    bool Commit()
+    {
+        const bool bCommitted = Transaction.Commit();
+        Reset();
+        return bCommitted;
+    }
+
+    FAbility& GetAbility() const { return Transaction.GetAbility(); }
+
+    // Discards every step without touching the FAbility.
+    void Cancel()
+    {
+        Transaction.Rollback();
+        Reset();
+    }
+
+private:
+    void Reset()
+    {
+        Steps.Reset();
+        Cursor = 0;
+    }
+
+    // Projected state over the FAbility.
+    FAbilityAllocationTransaction Transaction;
+
+    // Every step taken; steps at and after Cursor are the redo tail.
+    TArray<FAbilityAllocationDelta> Steps;
+
+    // Number of steps currently applied.
+    int32 Cursor = 0;
+};
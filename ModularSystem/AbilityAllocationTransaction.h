@@ -0,0 +1,218 @@
+#pragma once
+
+#include "AbilityData.h"
+
+/**
+ * Staged allocation of pool points into FAbility modules, committed or rejected as a whole.
+ *
+ * Every staged change is validated against running totals: the module's projected
+ * AllocatedPoint must stay within [0, MaxPoint] and the projected pool within
+ * [0, MaxAbilityPoints]. Only the staged modules and one pool delta are consulted, so a check
+ * never re-sums the five category maps. A rejected change leaves the transaction as it was.
+ *
+ * Nothing touches the FAbility until Commit, which applies one merged delta per module through
+ * FAbility::ApplyAllocationBatch. Because ApplyAllocationBatch keeps AbilityPoints and
+ * AllocatedPoints in step with the modules, a consistent pool stays consistent.
+ *
+ * Commit is for standalone FAbility values (tools, offline data). A transaction over a
+ * component's progression must be committed with UAbilityComponent::CommitAllocation, which goes
+ * through the component's allocation path: authority checks, journal, replication and derived stats.
+ *
+ * Staged changes are keyed by category and type and the modules are looked up on every access,
+ * so the FAbility may change underneath an open transaction, e.g. when replication overwrites a
+ * client's progression. Call Revalidate after such a change.
+ */
+class FAbilityAllocationTransaction
+{
+public:
+    explicit FAbilityAllocationTransaction(FAbility& InAbility)
+        : Ability(InAbility)
+    {
+    }
+
+    // Stages a signed number of points for a module. Returns false and stages nothing if the result would be invalid.
+    bool Allocate(EAbilityCategory Category, uint8 Type, int8 Delta)
+    {
+        if (Delta == 0)
+        {
+            return true;
+        }
+
+        const FAbilityModule* Module = static_cast<const FAbility&>(Ability).FindModule(Category, Type);
+        if (!Module)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Allocation references an unknown ability module."));
+            return false;
+        }
+
+        const FStagedModule* Existing = FindStaged(Category, Type);
+        const int32 NewAllocated = Module->AllocatedPoint + (Existing ? Existing->Delta : 0) + Delta;
+        if (NewAllocated < 0 || NewAllocated > Module->MaxPoint)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Allocation moves a module outside its point range."));
+            return false;
+        }
+
+        const int32 NewPool = Ability.GetAllocatedPoints() + PoolDelta + Delta;
+        if (NewPool < 0 || NewPool > Ability.GetMaxAbilityPoints())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Allocation exceeds the ability point pool."));
+            return false;
+        }
+
+        FStagedModule* Entry = const_cast<FStagedModule*>(Existing);
+        if (!Entry)
+        {
+            Entry = &Staged.Add_GetRef({ Category, Type, 0 });
+        }
+        Entry->Delta += Delta;
+        PoolDelta += Delta;
+        return true;
+    }
+
+    // Stages a whole batch; either every entry is staged or none is.
+    bool Allocate(TArrayView<const FAbilityAllocationDelta> Deltas)
+    {
+        const int32 NumStaged = Staged.Num();
+        const int32 PreviousPoolDelta = PoolDelta;
+        TArray<int32, TInlineAllocator<16>> PreviousDeltas;
+        for (const FStagedModule& Item : Staged)
+        {
+            PreviousDeltas.Add(Item.Delta);
+        }
+
+        for (const FAbilityAllocationDelta& Entry : Deltas)
+        {
+            if (!Allocate(Entry.Category, Entry.Type, Entry.Delta))
+            {
+                Staged.SetNum(NumStaged);
+                for (int32 Index = 0; Index < NumStaged; ++Index)
+                {
+                    Staged[Index].Delta = PreviousDeltas[Index];
+                }
+                PoolDelta = PreviousPoolDelta;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Projected allocated points of a module, including staged changes.
+    int32 GetAllocatedPoint(EAbilityCategory Category, uint8 Type) const
+    {
+        const FAbilityModule* Module = static_cast<const FAbility&>(Ability).FindModule(Category, Type);
+        if (!Module)
+        {
+            return 0;
+        }
+        const FStagedModule* Entry = FindStaged(Category, Type);
+        return Module->AllocatedPoint + (Entry ? Entry->Delta : 0);
+    }
+
+    // Projected pool total, including staged changes.
+    int32 GetAllocatedPoints() const { return Ability.GetAllocatedPoints() + PoolDelta; }
+
+    // Pool points still free to allocate after staged changes.
+    int32 GetAvailablePoints() const { return Ability.GetMaxAbilityPoints() - GetAllocatedPoints(); }
+
+    // Returns true if nothing effective is staged.
+    bool IsEmpty() const
+    {
+        for (const FStagedModule& Item : Staged)
+        {
+            if (Item.Delta != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Writes one merged delta per changed module, in the order modules were first staged.
+    template<typename AllocatorType>
+    void GetDeltas(TArray<FAbilityAllocationDelta, AllocatorType>& OutDeltas) const
+    {
+        OutDeltas.Reset();
+        for (const FStagedModule& Item : Staged)
+        {
+            if (Item.Delta != 0)
+            {
+                FAbilityAllocationDelta& Delta = OutDeltas.AddDefaulted_GetRef();
+                Delta.Category = Item.Category;
+                Delta.Type = Item.Type;
+                Delta.Delta = static_cast<int8>(Item.Delta);
+            }
+        }
+    }
+
+    // Applies the staged changes to a standalone FAbility in one batch and clears the transaction.
+    // Returns false if the batch was rejected.
+    bool Commit()
+    {
+        TArray<FAbilityAllocationDelta, TInlineAllocator<16>> Deltas;
+        GetDeltas(Deltas);
+
+        const bool bCommitted = Ability.ApplyAllocationBatch(Deltas);
+        Rollback();
+        return bCommitted;
+    }
+
+    /*
+     * Checks the staged changes against the FAbility as it is now, e.g. after replication replaced
+     * it. If any staged module or the pool would leave its range, every staged change is discarded.
+     * Returns true if the staged changes are still valid.
+     */
+    bool Revalidate()
+    {
+        const FAbility& Current = Ability;
+        for (const FStagedModule& Item : Staged)
+        {
+            const FAbilityModule* Module = Current.FindModule(Item.Category, Item.Type);
+            const int32 NewAllocated = Module ? Module->AllocatedPoint + Item.Delta : INDEX_NONE;
+            if (!Module || NewAllocated < 0 || NewAllocated > Module->MaxPoint)
+            {
+                Rollback();
+                return false;
+            }
+        }
+
+        const int32 NewPool = Current.GetAllocatedPoints() + PoolDelta;
+        if (NewPool < 0 || NewPool > Current.GetMaxAbilityPoints())
+        {
+            Rollback();
+            return false;
+        }
+        return true;
+    }
+
+    // Discards every staged change.
+    void Rollback()
+    {
+        Staged.Reset();
+        PoolDelta = 0;
+    }
+
+    FAbility& GetAbility() const { return Ability; }
+
+private:
+    // Accumulated change of one module, addressed like FAbilityAllocationDelta.
+    struct FStagedModule
+    {
+        EAbilityCategory Category = EAbilityCategory::Null;
+        uint8 Type = 0;
+        int32 Delta = 0;
+    };
+
+    const FStagedModule* FindStaged(EAbilityCategory Category, uint8 Type) const
+    {
+        return Staged.FindByPredicate([Category, Type](const FStagedModule& Item) { return Item.Category == Category && Item.Type == Type; });
+    }
+
+    FAbility& Ability;
+
+    // Modules touched by the transaction; transactions are small, so a linear scan beats hashing.
+    TArray<FStagedModule, TInlineAllocator<16>> Staged;
+
+    // Sum of all staged deltas.
+    int32 PoolDelta = 0;
+};
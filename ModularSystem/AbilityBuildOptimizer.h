@@ -0,0 +1,282 @@
+#pragma once
+
+#include "AbilityData.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+/**
+ * Offline evaluation of progression builds for balance tooling.
+ *
+ * A build is the AllocatedPoint of every progression module, packed one byte per module with
+ * every category padded to CategoryStride modules, so a category is three 4-lane vectors and a
+ * whole build is 64 bytes. Scoring is data-driven by FAbilityBuildTuning:
+ *
+ *   Score = sum over modules (Linear * P - Quadratic * P^2)
+ *         + sum over categories (Bonus if the category total reaches Threshold)
+ *
+ * The module terms are evaluated four lanes at a time. Candidates are generated and scored in
+ * chunks scheduled with ParallelFor on the task graph; each chunk keeps its own top list and the
+ * lists are merged at the end.
+ */
+namespace AbilityBuild
+{
+    // Module slots reserved per category.
+    constexpr int32 CategoryStride = 12;
+
+    // Number of categories, excluding Null.
+    constexpr int32 NumCategories = static_cast<int32>(EAbilityCategory::Max) - 1;
+
+    // Packed module slots per build.
+    constexpr int32 NumSlots = 64;
+
+    static_assert(NumCategories * CategoryStride <= NumSlots, "Ability categories do not fit a packed build");
+    static_assert(CategoryStride % 4 == 0, "Categories must cover whole vectors");
+    static_assert(static_cast<int32>(EMartialAbilityType::Max) - 1 <= CategoryStride, "EMartialAbilityType does not fit a packed build");
+    static_assert(static_cast<int32>(EMagicalAbilityType::Max) - 1 <= CategoryStride, "EMagicalAbilityType does not fit a packed build");
+    static_assert(static_cast<int32>(ECraftingAbilityType::Max) - 1 <= CategoryStride, "ECraftingAbilityType does not fit a packed build");
+    static_assert(static_cast<int32>(ESurvivalAbilityType::Max) - 1 <= CategoryStride, "ESurvivalAbilityType does not fit a packed build");
+    static_assert(static_cast<int32>(EStealthAbilityType::Max) - 1 <= CategoryStride, "EStealthAbilityType does not fit a packed build");
+
+    // Packed slot of a module.
+    constexpr int32 SlotIndex(EAbilityCategory Category, uint8 Type)
+    {
+        return (static_cast<int32>(Category) - 1) * CategoryStride + (Type - 1);
+    }
+
+    // Number of types of a category, excluding Null.
+    inline int32 NumTypes(EAbilityCategory Category)
+    {
+        switch (Category)
+        {
+        case EAbilityCategory::Martial:  return static_cast<int32>(EMartialAbilityType::Max) - 1;
+        case EAbilityCategory::Magical:  return static_cast<int32>(EMagicalAbilityType::Max) - 1;
+        case EAbilityCategory::Crafting: return static_cast<int32>(ECraftingAbilityType::Max) - 1;
+        case EAbilityCategory::Survival: return static_cast<int32>(ESurvivalAbilityType::Max) - 1;
+        case EAbilityCategory::Stealth:  return static_cast<int32>(EStealthAbilityType::Max) - 1;
+        default:                         return 0;
+        }
+    }
+}
+
+// Allocated points of every module, one byte per packed slot.
+struct alignas(16) FAbilityPackedBuild
+{
+    uint8 Points[AbilityBuild::NumSlots] = {};
+
+    // Packs the allocated points of an FAbility.
+    static FAbilityPackedBuild FromAbility(const FAbility& Ability)
+    {
+        FAbilityPackedBuild Build;
+        for (int32 Category = 1; Category <= AbilityBuild::NumCategories; ++Category)
+        {
+            for (int32 Type = 1; Type <= AbilityBuild::NumTypes(static_cast<EAbilityCategory>(Category)); ++Type)
+            {
+                FAbilityModule Module;
+                Ability.GetModule(static_cast<EAbilityCategory>(Category), static_cast<uint8>(Type), Module);
+                Build.Points[AbilityBuild::SlotIndex(static_cast<EAbilityCategory>(Category), static_cast<uint8>(Type))] = static_cast<uint8>(Module.AllocatedPoint);
+            }
+        }
+        return Build;
+    }
+
+    // Writes the allocation deltas that turn the FAbility's allocation into this build.
+    template<typename AllocatorType>
+    void GetDeltas(const FAbility& From, TArray<FAbilityAllocationDelta, AllocatorType>& OutDeltas) const
+    {
+        OutDeltas.Reset();
+        const FAbilityPackedBuild Current = FromAbility(From);
+        for (int32 Category = 1; Category <= AbilityBuild::NumCategories; ++Category)
+        {
+            for (int32 Type = 1; Type <= AbilityBuild::NumTypes(static_cast<EAbilityCategory>(Category)); ++Type)
+            {
+                const int32 Slot = AbilityBuild::SlotIndex(static_cast<EAbilityCategory>(Category), static_cast<uint8>(Type));
+                if (Points[Slot] != Current.Points[Slot])
+                {
+                    FAbilityAllocationDelta& Delta = OutDeltas.AddDefaulted_GetRef();
+                    Delta.Category = static_cast<EAbilityCategory>(Category);
+                    Delta.Type = static_cast<uint8>(Type);
+                    Delta.Delta = static_cast<int8>(Points[Slot] - Current.Points[Slot]);
+                }
+            }
+        }
+    }
+};
+
+// Scoring weights and constraints of a build search.
+struct alignas(16) FAbilityBuildTuning
+{
+    // Score per allocated point, per packed slot.
+    float Linear[AbilityBuild::NumSlots] = {};
+
+    // Diminishing returns per squared allocated point, per packed slot.
+    float Quadratic[AbilityBuild::NumSlots] = {};
+
+    // Highest allocation of each packed slot; unused slots stay 0.
+    uint8 MaxPoint[AbilityBuild::NumSlots] = {};
+
+    // Category total that earns the category bonus, indexed by category - 1.
+    float CategoryThreshold[AbilityBuild::NumCategories] = {};
+
+    // Bonus for reaching a category threshold, indexed by category - 1.
+    float CategoryBonus[AbilityBuild::NumCategories] = {};
+
+    // Pool points a build may allocate.
+    int32 Budget = 0;
+
+    // Default tuning: every module worth one point per allocation, capped by the module defaults.
+    static FAbilityBuildTuning MakeDefault(int32 InBudget)
+    {
+        FAbilityBuildTuning Tuning;
+        const FAbilityModule DefaultModule;
+        for (int32 Category = 1; Category <= AbilityBuild::NumCategories; ++Category)
+        {
+            for (int32 Type = 1; Type <= AbilityBuild::NumTypes(static_cast<EAbilityCategory>(Category)); ++Type)
+            {
+                const int32 Slot = AbilityBuild::SlotIndex(static_cast<EAbilityCategory>(Category), static_cast<uint8>(Type));
+                Tuning.Linear[Slot] = 1.f;
+                Tuning.MaxPoint[Slot] = static_cast<uint8>(DefaultModule.MaxPoint);
+            }
+        }
+        Tuning.Budget = InBudget;
+        return Tuning;
+    }
+};
+
+// A scored candidate.
+struct FAbilityRankedBuild
+{
+    int32 Index = INDEX_NONE;
+    float Score = 0.f;
+};
+
+class FAbilityBuildOptimizer
+{
+public:
+    // Builds generated and scored per scheduled chunk.
+    static constexpr int32 ChunkSize = 4096;
+
+    explicit FAbilityBuildOptimizer(const FAbilityBuildTuning& InTuning)
+        : Tuning(InTuning)
+    {
+    }
+
+    // Scores one build.
+    float Score(const FAbilityPackedBuild& Build) const
+    {
+        VectorRegister4Float Total = VectorZeroFloat();
+        float Bonus = 0.f;
+        for (int32 Category = 0; Category < AbilityBuild::NumCategories; ++Category)
+        {
+            VectorRegister4Float CategoryPoints = VectorZeroFloat();
+            for (int32 Lane = 0; Lane < AbilityBuild::CategoryStride; Lane += 4)
+            {
+                const int32 Slot = Category * AbilityBuild::CategoryStride + Lane;
+                const VectorRegister4Float Points = VectorLoadByte4(Build.Points + Slot);
+                const VectorRegister4Float Gain = VectorMultiply(Points, VectorLoadAligned(Tuning.Linear + Slot));
+                const VectorRegister4Float Loss = VectorMultiply(VectorMultiply(Points, Points), VectorLoadAligned(Tuning.Quadratic + Slot));
+                Total = VectorAdd(Total, VectorSubtract(Gain, Loss));
+                CategoryPoints = VectorAdd(CategoryPoints, Points);
+            }
+
+            if (VectorGetComponent(VectorDot4(CategoryPoints, VectorOneFloat()), 0) >= Tuning.CategoryThreshold[Category] && Tuning.CategoryThreshold[Category] > 0.f)
+            {
+                Bonus += Tuning.CategoryBonus[Category];
+            }
+        }
+        return VectorGetComponent(VectorDot4(Total, VectorOneFloat()), 0) + Bonus;
+    }
+
+    // Fills a random build that respects every module cap and the budget.
+    void RandomBuild(FRandomStream& Random, FAbilityPackedBuild& OutBuild) const
+    {
+        FMemory::Memzero(OutBuild.Points, sizeof(OutBuild.Points));
+
+        // Spend a random share of the budget one point at a time on modules with room left.
+        int32 Open[AbilityBuild::NumSlots];
+        int32 NumOpen = 0;
+        for (int32 Slot = 0; Slot < AbilityBuild::NumSlots; ++Slot)
+        {
+            if (Tuning.MaxPoint[Slot] > 0)
+            {
+                Open[NumOpen++] = Slot;
+            }
+        }
+
+        const int32 Points = Random.RandRange(0, Tuning.Budget);
+        for (int32 Point = 0; Point < Points && NumOpen > 0; ++Point)
+        {
+            const int32 Pick = Random.RandHelper(NumOpen);
+            const int32 Slot = Open[Pick];
+            if (++OutBuild.Points[Slot] >= Tuning.MaxPoint[Slot])
+            {
+                Open[Pick] = Open[--NumOpen];
+            }
+        }
+    }
+
+    // Generates candidates in parallel; chunk seeds derive from Seed, so results do not depend on scheduling.
+    void GenerateCandidates(int32 NumBuilds, int32 Seed, TArray<FAbilityPackedBuild>& OutBuilds) const
+    {
+        OutBuilds.SetNumUninitialized(NumBuilds);
+        const int32 NumChunks = FMath::DivideAndRoundUp(NumBuilds, ChunkSize);
+        ParallelFor(NumChunks, [this, NumBuilds, Seed, &OutBuilds](int32 Chunk)
+        {
+            FRandomStream Random(static_cast<int32>(HashCombine(GetTypeHash(Seed), GetTypeHash(Chunk))));
+            const int32 End = FMath::Min((Chunk + 1) * ChunkSize, NumBuilds);
+            for (int32 Index = Chunk * ChunkSize; Index < End; ++Index)
+            {
+                RandomBuild(Random, OutBuilds[Index]);
+            }
+        });
+    }
+
+    // Scores every build in parallel and writes the best ones, highest score first.
+    void Rank(TConstArrayView<FAbilityPackedBuild> Builds, int32 TopCount, TArray<FAbilityRankedBuild>& OutRanked) const
+    {
+        OutRanked.Reset();
+        if (Builds.IsEmpty() || TopCount <= 0)
+        {
+            return;
+        }
+
+        const int32 NumChunks = FMath::DivideAndRoundUp(Builds.Num(), ChunkSize);
+        TArray<TArray<FAbilityRankedBuild>> ChunkTops;
+        ChunkTops.SetNum(NumChunks);
+
+        ParallelFor(NumChunks, [this, Builds, TopCount, &ChunkTops](int32 Chunk)
+        {
+            // Min-heap of the chunk's best builds; the root is the weakest one kept.
+            TArray<FAbilityRankedBuild>& Top = ChunkTops[Chunk];
+            Top.Reserve(TopCount);
+            const auto ByScore = [](const FAbilityRankedBuild& A, const FAbilityRankedBuild& B) { return A.Score < B.Score; };
+
+            const int32 End = FMath::Min((Chunk + 1) * ChunkSize, Builds.Num());
+            for (int32 Index = Chunk * ChunkSize; Index < End; ++Index)
+            {
+                const float BuildScore = Score(Builds[Index]);
+                if (Top.Num() < TopCount)
+                {
+                    Top.HeapPush({ Index, BuildScore }, ByScore);
+                }
+                else if (BuildScore > Top.HeapTop().Score)
+                {
+                    FAbilityRankedBuild Discarded;
+                    Top.HeapPop(Discarded, ByScore, EAllowShrinking::No);
+                    Top.HeapPush({ Index, BuildScore }, ByScore);
+                }
+            }
+        });
+
+        for (const TArray<FAbilityRankedBuild>& Top : ChunkTops)
+        {
+            OutRanked.Append(Top);
+        }
+        OutRanked.Sort([](const FAbilityRankedBuild& A, const FAbilityRankedBuild& B) { return A.Score != B.Score ? A.Score > B.Score : A.Index < B.Index; });
+        OutRanked.SetNum(FMath::Min(OutRanked.Num(), TopCount));
+    }
+
+    const FAbilityBuildTuning& GetTuning() const { return Tuning; }
+
+private:
+    FAbilityBuildTuning Tuning;
+};
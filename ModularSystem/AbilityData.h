@@ -1,3 +1,7 @@
+#pragma once
+
+#include "AbilityStats.h"
+
 /**
  * This data structure serves as a modular and extensible example designed primarily for educational purposes.
  * It offers a highly flexible framework that allows developers to easily add, modify, or remove ability categories
@@ -34,10 +38,10 @@ inline bool AreMapsEqual(const TMap<KeyType, ValueType>& MapA, const TMap<KeyTyp
     }
 
     // Iterate over MapA and check if all key-value pairs exist in MapB
-    for (TPair<KeyType, ValueType>& PairA : MapA)
+    for (const TPair<KeyType, ValueType>& PairA : MapA)
     {
         // Check if MapB contains the same key and value
-        ValueType* ValueB = MapB.Find(PairA.Key);
+        const ValueType* ValueB = MapB.Find(PairA.Key);
         if (!ValueB || *ValueB != PairA.Value)
         {
             return false;
@@ -79,7 +83,28 @@ public:
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Ability", meta = (ClampMin = "0"))
     int8 AllocatedPoint = 0;
 
+    // Respec generation of the owning FAbility category this module was last brought up to date with.
+    // Bookkeeping for lazy resets only; not part of the module's value. Saved with the module so a
+    // pending respec survives tagged serialization.
+    UPROPERTY()
+    uint32 Generation = 0;
+
 public:
+    // Equality compares the module's value; the respec generation is bookkeeping and ignored.
+    bool operator==(const FAbilityModule& Other) const
+    {
+        return bUnlocked == Other.bUnlocked
+            && Point == Other.Point
+            && MaxPoint == Other.MaxPoint
+            && AllocatedPoint == Other.AllocatedPoint;
+    }
+
+    // Inequality operator returns the negation of equality.
+    bool operator!=(const FAbilityModule& Other) const
+    {
+        return !(*this == Other);
+    }
+
     // Resets the ability to its default locked state with zero points.
     void Reset()
     {
@@ -90,23 +115,46 @@ public:
     }
 
     // Increases active points within allowed limits and updates unlock status.
-    void IncreasePoint()
+    // Returns true if the module changed.
+    bool IncreasePoint()
     {
         if (Point < MaxPoint && Point < AllocatedPoint)
         {
             ++Point;
             UpdateUnlockStatus();
+            return true;
         }
+        return false;
     }
 
     // Decreases active points if possible and updates unlock status.
-    void DecreasePoint()
+    // Returns true if the module changed.
+    bool DecreasePoint()
     {
         if (Point > 0)
         {
             --Point;
             UpdateUnlockStatus();
+            return true;
         }
+        return false;
+    }
+
+    // Sets the points allocated from the pool, pulling active points down if they no longer fit.
+    // Returns true if the module changed.
+    bool SetAllocatedPoint(int8 NewAllocatedPoint)
+    {
+        if (AllocatedPoint == NewAllocatedPoint)
+        {
+            return false;
+        }
+        AllocatedPoint = NewAllocatedPoint;
+        if (Point > AllocatedPoint)
+        {
+            Point = AllocatedPoint;
+            UpdateUnlockStatus();
+        }
+        return true;
     }
 
 private:
@@ -206,21 +254,15 @@ public:
     }
 
     // Increases the points for the specified ability type if valid.
-    void IncreaseAbilityByType(EMagicalAbilityType Type)
+    bool IncreaseAbilityByType(EMagicalAbilityType Type)
     {
-        if (ValidateAbilityByType(Type))
-        {
-            MagicalAbilities[Type].IncreasePoint();
-        }
+        return ValidateAbilityByType(Type) && MagicalAbilities[Type].IncreasePoint();
     }
 
     // Decreases the points for the specified ability type if valid.
-    void DecreaseAbilityByType(EMagicalAbilityType Type)
+    bool DecreaseAbilityByType(EMagicalAbilityType Type)
     {
-        if (ValidateAbilityByType(Type))
-        {
-            MagicalAbilities[Type].DecreasePoint();
-        }
+        return ValidateAbilityByType(Type) && MagicalAbilities[Type].DecreasePoint();
     }
 };
 
@@ -310,21 +352,15 @@ public:
     }
 
     // Increases the point count for the specified crafting ability type.
-    void IncreaseAbilityByType(ECraftingAbilityType Type)
+    bool IncreaseAbilityByType(ECraftingAbilityType Type)
     {
-        if (ValidateAbilityByType(Type))
-        {
-            CraftingAbilities[Type].IncreasePoint();
-        }
+        return ValidateAbilityByType(Type) && CraftingAbilities[Type].IncreasePoint();
     }
 
     // Decreases the point count for the specified crafting ability type.
-    void DecreaseAbilityByType(ECraftingAbilityType Type)
+    bool DecreaseAbilityByType(ECraftingAbilityType Type)
     {
-        if (ValidateAbilityByType(Type))
-        {
-            CraftingAbilities[Type].DecreasePoint();
-        }
+        return ValidateAbilityByType(Type) && CraftingAbilities[Type].DecreasePoint();
     }
 };
 
@@ -414,21 +450,15 @@ public:
     }
 
     // Increases points of the specified survival ability.
-    void IncreaseAbilityByType(ESurvivalAbilityType Type)
+    bool IncreaseAbilityByType(ESurvivalAbilityType Type)
     {
-        if (ValidateAbilityByType(Type))
-        {
-            SurvivalAbilities[Type].IncreasePoint();
-        }
+        return ValidateAbilityByType(Type) && SurvivalAbilities[Type].IncreasePoint();
     }
 
     // Decreases points of the specified survival ability.
-    void DecreaseAbilityByType(ESurvivalAbilityType Type)
+    bool DecreaseAbilityByType(ESurvivalAbilityType Type)
     {
-        if (ValidateAbilityByType(Type))
-        {
-            SurvivalAbilities[Type].DecreasePoint();
-        }
+        return ValidateAbilityByType(Type) && SurvivalAbilities[Type].DecreasePoint();
     }
 };
 
@@ -518,25 +548,57 @@ public:
     }
 
     // Increments the point count for the specified ability
-    void IncreaseAbilityByType(EStealthAbilityType Type)
+    bool IncreaseAbilityByType(EStealthAbilityType Type)
     {
-        if (ValidateAbilityByType(Type))
-        {
-            StealthAbilities[Type].IncreasePoint();
-        }
+        return ValidateAbilityByType(Type) && StealthAbilities[Type].IncreasePoint();
     }
 
     // Decrements the point count for the specified ability
-    void DecreaseAbilityByType(EStealthAbilityType Type)
+    bool DecreaseAbilityByType(EStealthAbilityType Type)
     {
-        if (ValidateAbilityByType(Type))
-        {
-            StealthAbilities[Type].DecreasePoint();
-        }
+        return ValidateAbilityByType(Type) && StealthAbilities[Type].DecreasePoint();
     }
 };
 
 
+UENUM(BlueprintType)
+enum class EAbilityCategory : uint8
+{
+    Null                 UMETA(DisplayName = "Select Ability Category"),
+    Martial              UMETA(DisplayName = "Martial"),
+    Magical              UMETA(DisplayName = "Magical"),
+    Crafting             UMETA(DisplayName = "Crafting"),
+    Survival             UMETA(DisplayName = "Survival"),
+    Stealth              UMETA(DisplayName = "Stealth"),
+    Max                  UMETA(Hidden)
+};
+
+
+/*
+ * A single entry of a point allocation batch.
+ * Type holds the raw value of the category's ability enum so that one compact list
+ * can address modules of every category.
+ */
+USTRUCT(BlueprintType)
+struct FAbilityAllocationDelta
+{
+    GENERATED_BODY()
+
+public:
+    // Category of the ability module to allocate into.
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Ability")
+    EAbilityCategory Category = EAbilityCategory::Null;
+
+    // Raw enum value of the ability type within the category.
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Ability")
+    uint8 Type = 0;
+
+    // Signed number of pool points to allocate (positive) or refund (negative).
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Ability")
+    int8 Delta = 0;
+};
+
+
 USTRUCT(BlueprintType)
 struct FAbility
 {
@@ -575,15 +637,25 @@ private:
     UPROPERTY(BlueprintReadWrite, EditAnywhere)
     int32 AllocatedPoints = 0;
 
+    // Respec generation per category. While a category's generation is ahead of its resolved
+    // generation, modules stamped with an older generation read as default.
+    UPROPERTY()
+    uint32 Generations[static_cast<int32>(EAbilityCategory::Max)] = {};
+
+    // Generation every module of each category has been brought up to date with.
+    UPROPERTY()
+    uint32 ResolvedGenerations[static_cast<int32>(EAbilityCategory::Max)] = {};
+
 public:
     // Equality operator: returns true if all ability categories and summary fields are equal.
+    // Modules left stale by a pending respec compare as default modules.
     bool operator==(const FAbility& Other) const
     {
-        return MartialAbility == Other.MartialAbility
-            && MagicalAbility == Other.MagicalAbility
-            && CraftingAbility == Other.CraftingAbility
-            && SurvivalAbility == Other.SurvivalAbility
-            && StealthAbility == Other.StealthAbility
+        return CategoryEquals(EAbilityCategory::Martial, MartialAbility.GetAbilities(), Other, Other.MartialAbility.GetAbilities())
+            && CategoryEquals(EAbilityCategory::Magical, MagicalAbility.GetAbilities(), Other, Other.MagicalAbility.GetAbilities())
+            && CategoryEquals(EAbilityCategory::Crafting, CraftingAbility.GetAbilities(), Other, Other.CraftingAbility.GetAbilities())
+            && CategoryEquals(EAbilityCategory::Survival, SurvivalAbility.GetAbilities(), Other, Other.SurvivalAbility.GetAbilities())
+            && CategoryEquals(EAbilityCategory::Stealth, StealthAbility.GetAbilities(), Other, Other.StealthAbility.GetAbilities())
             && AbilityPoints == Other.AbilityPoints
             && MaxAbilityPoints == Other.MaxAbilityPoints
             && AllocatedPoints == Other.AllocatedPoints;
@@ -595,6 +667,250 @@ public:
         return !(*this == Other);
     }
 
+    // Upper bound on entries accepted in a single allocation batch.
+    static constexpr int32 MaxAllocationBatchSize = 64;
+
+    // Returns the module of the given category and raw type value, or nullptr if it does not exist.
+    // A module left stale by a respec is reset here on first access.
+    FAbilityModule* FindModule(EAbilityCategory Category, uint8 Type)
+    {
+        FAbilityModule* Module = FindStoredModule(Category, Type);
+        if (Module && IsStale(Category, *Module))
+        {
+            Module->Reset();
+            Module->Generation = Generations[static_cast<int32>(Category)];
+        }
+        return Module;
+    }
+
+    // Const overload of FindModule. A module left stale by a respec reads as a default module;
+    // nothing is written, so concurrent const reads are safe.
+    const FAbilityModule* FindModule(EAbilityCategory Category, uint8 Type) const
+    {
+        const FAbilityModule* Module = FindStoredModule(Category, Type);
+        return Module ? &ReadModule(Category, *Module) : nullptr;
+    }
+
+    // Copies the module of the given category and raw type value. Missing modules report their defaults and return false.
+    bool GetModule(EAbilityCategory Category, uint8 Type, FAbilityModule& OutModule) const
+    {
+        ABILITY_SCOPE_OPERATION(ProgressionLookup, Category, Type);
+        if (const FAbilityModule* Module = FindModule(Category, Type))
+        {
+            OutModule = *Module;
+            return true;
+        }
+        OutModule = FAbilityModule();
+        return false;
+    }
+
+    // Increases the active points of the given module. Returns true if the module changed.
+    bool IncreaseAbilityByCategory(EAbilityCategory Category, uint8 Type)
+    {
+        ABILITY_SCOPE_OPERATION(ProgressionChange, Category, Type);
+        FAbilityModule* Module = FindModule(Category, Type);
+        if (!Module || !Module->IncreasePoint())
+        {
+            return false;
+        }
+        ++AbilityPoints;
+        return true;
+    }
+
+    // Decreases the active points of the given module. Returns true if the module changed.
+    bool DecreaseAbilityByCategory(EAbilityCategory Category, uint8 Type)
+    {
+        ABILITY_SCOPE_OPERATION(ProgressionChange, Category, Type);
+        FAbilityModule* Module = FindModule(Category, Type);
+        if (!Module || !Module->DecreasePoint())
+        {
+            return false;
+        }
+        --AbilityPoints;
+        return true;
+    }
+
+    /*
+     * Applies a batch of allocation deltas against the point pool as one transaction.
+     * Every entry is resolved and the accumulated result validated first: each module must stay
+     * within [0, MaxPoint] and the pool within [0, MaxAbilityPoints]. If anything is invalid the
+     * whole batch is rejected and no state is touched. Refunding below a module's active points
+     * pulls those points down with it.
+     * Returns true if the batch was committed.
+     */
+    bool ApplyAllocationBatch(TArrayView<const FAbilityAllocationDelta> Deltas)
+    {
+        ABILITY_SCOPE_OPERATION(Allocate, EAbilityCategory::Null, Deltas.Num());
+        if (Deltas.Num() > MaxAllocationBatchSize)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Allocation batch exceeds %d entries."), MaxAllocationBatchSize);
+            return false;
+        }
+
+        // Resolve entries and accumulate per-module deltas without modifying anything.
+        TArray<TPair<FAbilityModule*, int32>, TInlineAllocator<16>> Pending;
+        int32 PoolDelta = 0;
+        for (const FAbilityAllocationDelta& Entry : Deltas)
+        {
+            FAbilityModule* Module = FindModule(Entry.Category, Entry.Type);
+            if (!Module)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Allocation batch references an unknown ability module."));
+                return false;
+            }
+
+            TPair<FAbilityModule*, int32>* Existing = Pending.FindByPredicate([Module](const TPair<FAbilityModule*, int32>& Item) { return Item.Key == Module; });
+            if (Existing)
+            {
+                Existing->Value += Entry.Delta;
+            }
+            else
+            {
+                Pending.Emplace(Module, Entry.Delta);
+            }
+            PoolDelta += Entry.Delta;
+        }
+
+        for (const TPair<FAbilityModule*, int32>& Item : Pending)
+        {
+            const int32 NewAllocated = Item.Key->AllocatedPoint + Item.Value;
+            if (NewAllocated < 0 || NewAllocated > Item.Key->MaxPoint)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Allocation batch moves a module outside its point range."));
+                return false;
+            }
+        }
+
+        const int32 NewAllocatedPoints = AllocatedPoints + PoolDelta;
+        if (NewAllocatedPoints < 0 || NewAllocatedPoints > MaxAbilityPoints)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Allocation batch exceeds the ability point pool."));
+            return false;
+        }
+
+        // Commit.
+        for (const TPair<FAbilityModule*, int32>& Item : Pending)
+        {
+            const int8 OldPoint = Item.Key->Point;
+            Item.Key->SetAllocatedPoint(static_cast<int8>(Item.Key->AllocatedPoint + Item.Value));
+            AbilityPoints += Item.Key->Point - OldPoint;
+        }
+        AllocatedPoints = NewAllocatedPoints;
+        return true;
+    }
+
+    /*
+     * Resets every module of every category and refunds the whole pool in constant time.
+     * Only the category generations are bumped; each module is reset the first time it is
+     * accessed afterwards, and whole-map access resolves the remaining modules of a category
+     * in one pass. MaxAbilityPoints is kept.
+     */
+    void ResetAllAbilities()
+    {
+        for (int32 Category = static_cast<int32>(EAbilityCategory::Null) + 1; Category < static_cast<int32>(EAbilityCategory::Max); ++Category)
+        {
+            ++Generations[Category];
+        }
+        AbilityPoints = 0;
+        AllocatedPoints = 0;
+    }
+
+    // Resets every module of one category and refunds its points. Refunding reads the category's modules once.
+    void ResetCategory(EAbilityCategory Category)
+    {
+        int32 Points = 0;
+        int32 Allocated = 0;
+        switch (Category)
+        {
+        case EAbilityCategory::Martial:  SumCategory(Category, MartialAbility.GetAbilities(), Points, Allocated); break;
+        case EAbilityCategory::Magical:  SumCategory(Category, MagicalAbility.GetAbilities(), Points, Allocated); break;
+        case EAbilityCategory::Crafting: SumCategory(Category, CraftingAbility.GetAbilities(), Points, Allocated); break;
+        case EAbilityCategory::Survival: SumCategory(Category, SurvivalAbility.GetAbilities(), Points, Allocated); break;
+        case EAbilityCategory::Stealth:  SumCategory(Category, StealthAbility.GetAbilities(), Points, Allocated); break;
+        default:                         return;
+        }
+        ++Generations[static_cast<int32>(Category)];
+        AbilityPoints -= Points;
+        AllocatedPoints -= Allocated;
+    }
+
+    /*
+     * Returns true if AbilityPoints and AllocatedPoints equal the sums of the modules' Point and
+     * AllocatedPoint. This scans every module; allocation paths keep the totals consistent
+     * incrementally, so it is meant for debugging and for validating untrusted data.
+     */
+    bool IsPoolConsistent() const
+    {
+        int32 Points = 0;
+        int32 Allocated = 0;
+        SumCategory(EAbilityCategory::Martial, MartialAbility.GetAbilities(), Points, Allocated);
+        SumCategory(EAbilityCategory::Magical, MagicalAbility.GetAbilities(), Points, Allocated);
+        SumCategory(EAbilityCategory::Crafting, CraftingAbility.GetAbilities(), Points, Allocated);
+        SumCategory(EAbilityCategory::Survival, SurvivalAbility.GetAbilities(), Points, Allocated);
+        SumCategory(EAbilityCategory::Stealth, StealthAbility.GetAbilities(), Points, Allocated);
+        return Points == AbilityPoints && Allocated == AllocatedPoints;
+    }
+
+    // Recomputes AbilityPoints and AllocatedPoints from the modules, e.g. after importing edited data.
+    void RecomputePoolTotals()
+    {
+        AbilityPoints = 0;
+        AllocatedPoints = 0;
+        SumCategory(EAbilityCategory::Martial, MartialAbility.GetAbilities(), AbilityPoints, AllocatedPoints);
+        SumCategory(EAbilityCategory::Magical, MagicalAbility.GetAbilities(), AbilityPoints, AllocatedPoints);
+        SumCategory(EAbilityCategory::Crafting, CraftingAbility.GetAbilities(), AbilityPoints, AllocatedPoints);
+        SumCategory(EAbilityCategory::Survival, SurvivalAbility.GetAbilities(), AbilityPoints, AllocatedPoints);
+        SumCategory(EAbilityCategory::Stealth, StealthAbility.GetAbilities(), AbilityPoints, AllocatedPoints);
+    }
+
+    // Heap bytes of the module map of one category.
+    SIZE_T GetCategoryAllocatedSize(EAbilityCategory Category) const
+    {
+        switch (Category)
+        {
+        case EAbilityCategory::Martial:  return MartialAbility.GetAbilities().GetAllocatedSize();
+        case EAbilityCategory::Magical:  return MagicalAbility.GetAbilities().GetAllocatedSize();
+        case EAbilityCategory::Crafting: return CraftingAbility.GetAbilities().GetAllocatedSize();
+        case EAbilityCategory::Survival: return SurvivalAbility.GetAbilities().GetAllocatedSize();
+        case EAbilityCategory::Stealth:  return StealthAbility.GetAbilities().GetAllocatedSize();
+        default:                         return 0;
+        }
+    }
+
+    // Heap bytes of every module map; the struct itself is not included.
+    SIZE_T GetAllocatedSize() const
+    {
+        SIZE_T Size = 0;
+        for (int32 Category = static_cast<int32>(EAbilityCategory::Null) + 1; Category < static_cast<int32>(EAbilityCategory::Max); ++Category)
+        {
+            Size += GetCategoryAllocatedSize(static_cast<EAbilityCategory>(Category));
+        }
+        return Size;
+    }
+
+    /*
+     * Network serialization used when FAbility is replicated.
+     * Nested TMaps are not replicated by the property system, so the pool and every module
+     * are written out explicitly.
+     */
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+    {
+        ABILITY_SCOPE_OPERATION(Serialize, EAbilityCategory::Null, 0);
+        // The mutable map getters below resolve pending respecs, so only current values go on the wire.
+        Ar.SerializeIntPacked(*reinterpret_cast<uint32*>(&AbilityPoints));
+        Ar.SerializeIntPacked(*reinterpret_cast<uint32*>(&MaxAbilityPoints));
+        Ar.SerializeIntPacked(*reinterpret_cast<uint32*>(&AllocatedPoints));
+
+        NetSerializeCategory(Ar, GetMartialAbilities());
+        NetSerializeCategory(Ar, GetMagicalAbilities());
+        NetSerializeCategory(Ar, GetCraftingAbilities());
+        NetSerializeCategory(Ar, GetSurvivalAbilities());
+        NetSerializeCategory(Ar, GetStealthAbilities());
+
+        bOutSuccess = !Ar.IsError();
+        return true;
+    }
+
     
     // Returns the total number of active ability points across all abilities.
     int32 GetAbilityPoints() const { return AbilityPoints; }
@@ -614,14 +930,18 @@ public:
     void SetMaxAbilityPoints(int32 NewMaxPoints) { MaxAbilityPoints = NewMaxPoints; }
     
     // Sets the total allocated points from the character's pool.
+    // Overwrites the total as is; use FAbilityAllocationTransaction or ApplyAllocationBatch to move points.
     void SetAllocatedPoints(int32 NewAllocatedPoints) { AllocatedPoints = NewAllocatedPoints; }
     
     // Getters for ability maps inside structs
+    // The mutable getters reset the modules left stale by a respec before handing out the map.
+    // The const getters never write: they return the maps as stored, so while a respec of the
+    // category is pending, read module values through FindModule, GetModule or ReadModule.
     
     // Returns a mutable reference to the Martial abilities map.
     TMap<EMartialAbilityType, FAbilityModule>& GetMartialAbilities()
     {
-        return MartialAbility.GetAbilities();
+        return ResolveCategory(EAbilityCategory::Martial, MartialAbility.GetAbilities());
     }
     
     // Returns a const reference to the Martial abilities map.
@@ -633,7 +953,7 @@ public:
     // Returns a mutable reference to the Magical abilities map.
     TMap<EMagicalAbilityType, FAbilityModule>& GetMagicalAbilities()
     {
-        return MagicalAbility.GetAbilities();
+        return ResolveCategory(EAbilityCategory::Magical, MagicalAbility.GetAbilities());
     }
     
     // Returns a const reference to the Magical abilities map.
@@ -645,7 +965,7 @@ public:
     // Returns a mutable reference to the Crafting abilities map.
     TMap<ECraftingAbilityType, FAbilityModule>& GetCraftingAbilities()
     {
-        return CraftingAbility.GetAbilities();
+        return ResolveCategory(EAbilityCategory::Crafting, CraftingAbility.GetAbilities());
     }
     
     // Returns a const reference to the Crafting abilities map.
@@ -657,7 +977,7 @@ public:
     // Returns a mutable reference to the Survival abilities map.
     TMap<ESurvivalAbilityType, FAbilityModule>& GetSurvivalAbilities()
     {
-        return SurvivalAbility.GetAbilities();
+        return ResolveCategory(EAbilityCategory::Survival, SurvivalAbility.GetAbilities());
     }
     
     // Returns a const reference to the Survival abilities map.
@@ -669,7 +989,7 @@ public:
     // Returns a mutable reference to the Stealth abilities map.
     TMap<EStealthAbilityType, FAbilityModule>& GetStealthAbilities()
     {
-        return StealthAbility.GetAbilities();
+        return ResolveCategory(EAbilityCategory::Stealth, StealthAbility.GetAbilities());
     }
     
     // Returns a const reference to the Stealth abilities map.
@@ -684,30 +1004,35 @@ public:
     void SetMartialAbilities(const TMap<EMartialAbilityType, FAbilityModule>& NewAbilities)
     {
         MartialAbility.SetAbilities(NewAbilities);
+        ResolvedGenerations[static_cast<int32>(EAbilityCategory::Martial)] = Generations[static_cast<int32>(EAbilityCategory::Martial)];
     }
     
     // Replaces the Magical abilities map with a new one.
     void SetMagicalAbilities(const TMap<EMagicalAbilityType, FAbilityModule>& NewAbilities)
     {
         MagicalAbility.SetAbilities(NewAbilities);
+        ResolvedGenerations[static_cast<int32>(EAbilityCategory::Magical)] = Generations[static_cast<int32>(EAbilityCategory::Magical)];
     }
     
     // Replaces the Crafting abilities map with a new one.
     void SetCraftingAbilities(const TMap<ECraftingAbilityType, FAbilityModule>& NewAbilities)
     {
         CraftingAbility.SetAbilities(NewAbilities);
+        ResolvedGenerations[static_cast<int32>(EAbilityCategory::Crafting)] = Generations[static_cast<int32>(EAbilityCategory::Crafting)];
     }
     
     // Replaces the Survival abilities map with a new one.
     void SetSurvivalAbilities(const TMap<ESurvivalAbilityType, FAbilityModule>& NewAbilities)
     {
         SurvivalAbility.SetAbilities(NewAbilities);
+        ResolvedGenerations[static_cast<int32>(EAbilityCategory::Survival)] = Generations[static_cast<int32>(EAbilityCategory::Survival)];
     }
     
     // Replaces the Stealth abilities map with a new one.
     void SetStealthAbilities(const TMap<EStealthAbilityType, FAbilityModule>& NewAbilities)
     {
         StealthAbility.SetAbilities(NewAbilities);
+        ResolvedGenerations[static_cast<int32>(EAbilityCategory::Stealth)] = Generations[static_cast<int32>(EAbilityCategory::Stealth)];
     }
     
     // Template functions for ability operations
@@ -740,6 +1065,129 @@ public:
         Ability.DowngradeAbilityByType(Type);
     }
 
+    // Returns the module as readers should see it: a default module if it was left stale by a
+    // pending respec of its category, otherwise the stored module. Never writes.
+    const FAbilityModule& ReadModule(EAbilityCategory Category, const FAbilityModule& Stored) const
+    {
+        static const FAbilityModule DefaultModule;
+        return IsStale(Category, Stored) ? DefaultModule : Stored;
+    }
+
+    // Resets every module left stale by a pending respec, e.g. before handing the maps to code
+    // that reads them directly.
+    void ResolvePendingRespecs()
+    {
+        GetMartialAbilities();
+        GetMagicalAbilities();
+        GetCraftingAbilities();
+        GetSurvivalAbilities();
+        GetStealthAbilities();
+    }
+
+private:
+    // Returns the module as stored, without resolving respecs.
+    FAbilityModule* FindStoredModule(EAbilityCategory Category, uint8 Type)
+    {
+        return const_cast<FAbilityModule*>(static_cast<const FAbility*>(this)->FindStoredModule(Category, Type));
+    }
+
+    // Const overload of FindStoredModule.
+    const FAbilityModule* FindStoredModule(EAbilityCategory Category, uint8 Type) const
+    {
+        switch (Category)
+        {
+        case EAbilityCategory::Martial:  return MartialAbility.GetAbilities().Find(static_cast<EMartialAbilityType>(Type));
+        case EAbilityCategory::Magical:  return MagicalAbility.GetAbilities().Find(static_cast<EMagicalAbilityType>(Type));
+        case EAbilityCategory::Crafting: return CraftingAbility.GetAbilities().Find(static_cast<ECraftingAbilityType>(Type));
+        case EAbilityCategory::Survival: return SurvivalAbility.GetAbilities().Find(static_cast<ESurvivalAbilityType>(Type));
+        case EAbilityCategory::Stealth:  return StealthAbility.GetAbilities().Find(static_cast<EStealthAbilityType>(Type));
+        default:                         return nullptr;
+        }
+    }
+
+    // Returns true if a respec of the category is pending and the module predates it.
+    bool IsStale(EAbilityCategory Category, const FAbilityModule& Module) const
+    {
+        const int32 Index = static_cast<int32>(Category);
+        return ResolvedGenerations[Index] != Generations[Index] && Module.Generation != Generations[Index];
+    }
+
+    // Resets every stale module of a category so the map can be read directly.
+    template<typename AbilityType>
+    TMap<AbilityType, FAbilityModule>& ResolveCategory(EAbilityCategory Category, TMap<AbilityType, FAbilityModule>& Abilities)
+    {
+        const int32 Index = static_cast<int32>(Category);
+        if (ResolvedGenerations[Index] != Generations[Index])
+        {
+            for (TPair<AbilityType, FAbilityModule>& Pair : Abilities)
+            {
+                if (Pair.Value.Generation != Generations[Index])
+                {
+                    Pair.Value.Reset();
+                    Pair.Value.Generation = Generations[Index];
+                }
+            }
+            ResolvedGenerations[Index] = Generations[Index];
+        }
+        return Abilities;
+    }
+
+    // Compares one category of two abilities as their readers see it.
+    template<typename AbilityType>
+    bool CategoryEquals(EAbilityCategory Category, const TMap<AbilityType, FAbilityModule>& Abilities, const FAbility& Other, const TMap<AbilityType, FAbilityModule>& OtherAbilities) const
+    {
+        if (Abilities.Num() != OtherAbilities.Num())
+        {
+            return false;
+        }
+        for (const TPair<AbilityType, FAbilityModule>& Pair : Abilities)
+        {
+            const FAbilityModule* OtherModule = OtherAbilities.Find(Pair.Key);
+            if (!OtherModule || ReadModule(Category, Pair.Value) != Other.ReadModule(Category, *OtherModule))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Adds the active and allocated points of one category, as its readers see it, to the running sums.
+    template<typename AbilityType>
+    void SumCategory(EAbilityCategory Category, const TMap<AbilityType, FAbilityModule>& Abilities, int32& InOutPoints, int32& InOutAllocated) const
+    {
+        for (const TPair<AbilityType, FAbilityModule>& Pair : Abilities)
+        {
+            const FAbilityModule& Module = ReadModule(Category, Pair.Value);
+            InOutPoints += Module.Point;
+            InOutAllocated += Module.AllocatedPoint;
+        }
+    }
+
+    // Writes or reads every module of one category in enum order.
+    template<typename AbilityType>
+    static void NetSerializeCategory(FArchive& Ar, TMap<AbilityType, FAbilityModule>& Abilities)
+    {
+        for (uint8 i = static_cast<uint8>(AbilityType::Null) + 1; i < static_cast<uint8>(AbilityType::Max); ++i)
+        {
+            FAbilityModule& Module = Abilities.FindOrAdd(static_cast<AbilityType>(i));
+            uint8 bUnlocked = Module.bUnlocked ? 1 : 0;
+            Ar.SerializeBits(&bUnlocked, 1);
+            Module.bUnlocked = bUnlocked != 0;
+            Ar << Module.Point;
+            Ar << Module.MaxPoint;
+            Ar << Module.AllocatedPoint;
+        }
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FAbility> : public TStructOpsTypeTraitsBase2<FAbility>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithIdenticalViaEquality = true,
+    };
 };
 
 
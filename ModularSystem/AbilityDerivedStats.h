@@ -0,0 +1,240 @@
+#pragma once
+
+#include "AbilityData.h"
+
+/**
+ * Derived gameplay modifiers (damage, speed, crafting speed, stealth rating, ...) computed from
+ * ability levels and progression points.
+ *
+ * A stat is a weighted sum of sources:
+ *
+ *   Stat = sum over terms (PerPoint * SourceValue)
+ *
+ * where a source is either a component ability slot (its level while unlocked) or a progression
+ * module (its active points). The terms come from data; FAbilityStatTable compiles them into a
+ * dependency mask per source, so a change to one source invalidates only the stats that read it.
+ * FAbilityDerivedStats caches the values and recomputes only the invalidated stats.
+ */
+namespace AbilityStatSource
+{
+    // Component ability slots, addressed like AbilitySlot.
+    constexpr int32 NumSlots = 32;
+
+    // Source indices reserved per progression category.
+    constexpr int32 ProgressionStride = 12;
+
+    // Number of progression categories, excluding Null.
+    constexpr int32 NumCategories = static_cast<int32>(EAbilityCategory::Max) - 1;
+
+    // Component slots first, then every progression category.
+    constexpr int32 Num = NumSlots + NumCategories * ProgressionStride;
+
+    static_assert(static_cast<int32>(EMartialAbilityType::Max) - 1 <= ProgressionStride, "EMartialAbilityType does not fit the stat sources");
+    static_assert(static_cast<int32>(EMagicalAbilityType::Max) - 1 <= ProgressionStride, "EMagicalAbilityType does not fit the stat sources");
+    static_assert(static_cast<int32>(ECraftingAbilityType::Max) - 1 <= ProgressionStride, "ECraftingAbilityType does not fit the stat sources");
+    static_assert(static_cast<int32>(ESurvivalAbilityType::Max) - 1 <= ProgressionStride, "ESurvivalAbilityType does not fit the stat sources");
+    static_assert(static_cast<int32>(EStealthAbilityType::Max) - 1 <= ProgressionStride, "EStealthAbilityType does not fit the stat sources");
+
+    // Source of a component ability slot.
+    constexpr int32 Slot(int32 SlotIndex)
+    {
+        return SlotIndex;
+    }
+
+    // Source of a progression module.
+    constexpr int32 Progression(EAbilityCategory Category, uint8 Type)
+    {
+        return NumSlots + (static_cast<int32>(Category) - 1) * ProgressionStride + (Type - 1);
+    }
+
+    // True if the source is a progression module.
+    constexpr bool IsProgression(int32 Source)
+    {
+        return Source >= NumSlots;
+    }
+
+    // Value of a progression source: the active points of its module.
+    inline float GetProgressionValue(const FAbility& Ability, int32 Source)
+    {
+        const int32 Offset = Source - NumSlots;
+        FAbilityModule Module;
+        Ability.GetModule(static_cast<EAbilityCategory>(Offset / ProgressionStride + 1), static_cast<uint8>(Offset % ProgressionStride + 1), Module);
+        return Module.Point;
+    }
+}
+
+/**
+ * Compiled stat terms of one definition variant.
+ *
+ * Terms are added in any order, then Compile groups them per stat and builds, for every source,
+ * the mask of stats that depend on it.
+ */
+class FAbilityStatTable
+{
+public:
+    // Stats are tracked as bits of a 64-bit mask.
+    static constexpr int32 MaxStats = 64;
+
+    // Adds PerPoint * SourceValue to a stat. Terms of the same stat and source add up.
+    void AddTerm(int32 Stat, int32 Source, float PerPoint)
+    {
+        check(Stat >= 0 && Stat < MaxStats && Source >= 0 && Source < AbilityStatSource::Num);
+        FPendingTerm& Pending = PendingTerms.AddDefaulted_GetRef();
+        Pending.Stat = Stat;
+        Pending.Term.Source = static_cast<uint16>(Source);
+        Pending.Term.PerPoint = PerPoint;
+        NumStats = FMath::Max(NumStats, Stat + 1);
+    }
+
+    // Builds the per-stat terms and the dependency masks from the added terms.
+    void Compile()
+    {
+        PendingTerms.StableSort([](const FPendingTerm& A, const FPendingTerm& B) { return A.Stat < B.Stat; });
+
+        Terms.Reset(PendingTerms.Num());
+        StatOffsets.Init(0, NumStats + 1);
+        FMemory::Memzero(DependentMasks, sizeof(DependentMasks));
+        ProgressionDependents = 0;
+
+        for (const FPendingTerm& Pending : PendingTerms)
+        {
+            Terms.Add(Pending.Term);
+            ++StatOffsets[Pending.Stat + 1];
+
+            const uint64 Bit = uint64(1) << Pending.Stat;
+            DependentMasks[Pending.Term.Source] |= Bit;
+            ProgressionDependents |= AbilityStatSource::IsProgression(Pending.Term.Source) ? Bit : 0;
+        }
+        for (int32 Stat = 0; Stat < NumStats; ++Stat)
+        {
+            StatOffsets[Stat + 1] += StatOffsets[Stat];
+        }
+    }
+
+    // Evaluates a stat; GetSourceValue maps a source index to its current value.
+    template<typename SourceFunc>
+    float Evaluate(int32 Stat, SourceFunc&& GetSourceValue) const
+    {
+        float Value = 0.f;
+        for (int32 Index = StatOffsets[Stat]; Index < StatOffsets[Stat + 1]; ++Index)
+        {
+            Value += Terms[Index].PerPoint * GetSourceValue(Terms[Index].Source);
+        }
+        return Value;
+    }
+
+    // Stats that read a source.
+    uint64 GetDependents(int32 Source) const { return DependentMasks[Source]; }
+
+    // Stats that read any progression module.
+    uint64 GetProgressionDependents() const { return ProgressionDependents; }
+
+    // Every compiled stat.
+    uint64 GetAllStats() const { return NumStats >= MaxStats ? ~uint64(0) : (uint64(1) << NumStats) - 1; }
+
+    int32 GetNumStats() const { return NumStats; }
+
+    int32 GetNumTerms() const { return Terms.Num(); }
+
+private:
+
+    // One weighted source of a stat.
+    struct FTerm
+    {
+        uint16 Source = 0;
+        float PerPoint = 0.f;
+    };
+
+    struct FPendingTerm
+    {
+        int32 Stat = 0;
+        FTerm Term;
+    };
+
+    // Terms as added, kept so more can be added before recompiling.
+    TArray<FPendingTerm> PendingTerms;
+
+    // Terms grouped by stat; the terms of stat S are [StatOffsets[S], StatOffsets[S + 1]).
+    TArray<FTerm> Terms;
+    TArray<int32> StatOffsets;
+
+    // Stat bits per source.
+    uint64 DependentMasks[AbilityStatSource::Num] = {};
+    uint64 ProgressionDependents = 0;
+
+    int32 NumStats = 0;
+};
+
+/**
+ * Cached stat values of one character.
+ *
+ * Invalidate marks the stats that depend on a changed source; Recompute evaluates only those, so
+ * any number of changes between two recomputes costs one evaluation per affected stat.
+ */
+class FAbilityDerivedStats
+{
+public:
+    // Binds a compiled table (or none) and marks every stat dirty. The table must outlive the binding.
+    void Bind(const FAbilityStatTable* InTable)
+    {
+        Table = InTable;
+        Values.Init(0.f, Table ? Table->GetNumStats() : 0);
+        DirtyMask = Table ? Table->GetAllStats() : 0;
+    }
+
+    // Marks the stats that read a source.
+    void Invalidate(int32 Source)
+    {
+        DirtyMask |= Table ? Table->GetDependents(Source) : 0;
+    }
+
+    // Marks the stats that read any progression module, e.g. after a respec.
+    void InvalidateProgression()
+    {
+        DirtyMask |= Table ? Table->GetProgressionDependents() : 0;
+    }
+
+    // Marks every stat.
+    void InvalidateAll()
+    {
+        DirtyMask |= Table ? Table->GetAllStats() : 0;
+    }
+
+    bool IsDirty() const { return DirtyMask != 0; }
+
+    // Re-evaluates the dirty stats and returns the bits of those whose value changed.
+    template<typename SourceFunc>
+    uint64 Recompute(SourceFunc&& GetSourceValue)
+    {
+        uint64 ChangedMask = 0;
+        for (uint64 Pending = DirtyMask; Pending != 0; Pending &= Pending - 1)
+        {
+            const int32 Stat = static_cast<int32>(FMath::CountTrailingZeros64(Pending));
+            const float Value = Table->Evaluate(Stat, GetSourceValue);
+            ChangedMask |= Value != Values[Stat] ? uint64(1) << Stat : 0;
+            Values[Stat] = Value;
+        }
+        DirtyMask = 0;
+        return ChangedMask;
+    }
+
+    // Cached value of a stat, or 0 if it is unknown. Only current after Recompute.
+    float Get(int32 Stat) const
+    {
+        return Values.IsValidIndex(Stat) ? Values[Stat] : 0.f;
+    }
+
+    const FAbilityStatTable* GetTable() const { return Table; }
+
+    // Heap bytes of the cached values; the table is shared and not included.
+    SIZE_T GetAllocatedSize() const { return Values.GetAllocatedSize(); }
+
+private:
+
+    const FAbilityStatTable* Table = nullptr;
+
+    TArray<float> Values;
+
+    // Stats whose cached value is out of date.
+    uint64 DirtyMask = 0;
+};
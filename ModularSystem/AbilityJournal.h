@@ -0,0 +1,197 @@
+#pragma once
+
+#include "AbilitySaveFormat.h"
+
+/**
+ * Append-only journal of progression mutations on top of a compact snapshot.
+ *
+ * Every entry stores the absolute state it leaves behind (a module record or the point pool),
+ * so replay is idempotent and entries for the same module simply overwrite each other.
+ * Persisting a change means appending a handful of bytes to the log; once the log grows past
+ * the compaction threshold the owner folds it into a fresh snapshot.
+ *
+ * Log entry layout:
+ *   Module : Op (uint8), Category (uint8), Type (uint8), packed module record (AbilitySaveFormat::RecordSize bytes)
+ *   Pool   : Op (uint8), AbilityPoints, MaxAbilityPoints, AllocatedPoints (int32 each)
+ *   Respec : Op (uint8); replays FAbility::ResetAllAbilities
+ */
+enum class EAbilityJournalOp : uint8
+{
+    Null,
+    Module,
+    Pool,
+    Respec,
+    Max
+};
+
+class FAbilityJournal
+{
+public:
+    // Number of entries after which NeedsCompaction reports true.
+    static constexpr int32 DefaultCompactionThreshold = 256;
+
+    explicit FAbilityJournal(int32 InCompactionThreshold = DefaultCompactionThreshold)
+        : CompactionThreshold(InCompactionThreshold)
+    {
+    }
+
+    // Records the current state of a module after an unlock or point change.
+    void AppendModule(EAbilityCategory Category, uint8 Type, const FAbilityModule& Module)
+    {
+        const int32 Offset = Log.AddUninitialized(3 + AbilitySaveFormat::RecordSize);
+        uint8* Entry = Log.GetData() + Offset;
+        Entry[0] = static_cast<uint8>(EAbilityJournalOp::Module);
+        Entry[1] = static_cast<uint8>(Category);
+        Entry[2] = Type;
+        AbilitySaveFormat::PackModule(Module, Entry + 3);
+        ++NumEntries;
+    }
+
+    // Records the current point pool after it changed.
+    void AppendPool(const FAbility& Ability)
+    {
+        const int32 Pool[3] = { Ability.GetAbilityPoints(), Ability.GetMaxAbilityPoints(), Ability.GetAllocatedPoints() };
+        const int32 Offset = Log.AddUninitialized(1 + sizeof(Pool));
+        uint8* Entry = Log.GetData() + Offset;
+        Entry[0] = static_cast<uint8>(EAbilityJournalOp::Pool);
+        FMemory::Memcpy(Entry + 1, Pool, sizeof(Pool));
+        ++NumEntries;
+    }
+
+    // Records a full respec; one byte regardless of how many modules it resets.
+    void AppendRespec()
+    {
+        Log.Add(static_cast<uint8>(EAbilityJournalOp::Respec));
+        ++NumEntries;
+    }
+
+    // Heap bytes held by the snapshot and the log.
+    SIZE_T GetAllocatedSize() const
+    {
+        return Snapshot.GetAllocatedSize() + Log.GetAllocatedSize();
+    }
+
+    // Returns true once the log is long enough to be folded into the snapshot.
+    bool NeedsCompaction() const
+    {
+        return NumEntries >= CompactionThreshold;
+    }
+
+    // Replaces the snapshot with the given state and clears the log.
+    void Compact(const FAbility& Current)
+    {
+        Snapshot.Reset();
+        AbilitySaveFormat::SaveToBytes(Current, Snapshot);
+        Log.Reset();
+        NumEntries = 0;
+    }
+
+    // Restores persisted snapshot and log bytes, e.g. after reading them back from storage.
+    void Restore(TArray<uint8> InSnapshot, TArray<uint8> InLog)
+    {
+        Snapshot = MoveTemp(InSnapshot);
+        Log = MoveTemp(InLog);
+        NumEntries = CountEntries(Log);
+    }
+
+    /*
+     * Rebuilds the ability from the last snapshot and replays the log on top of it.
+     * An empty snapshot starts from a default FAbility.
+     * Returns false if the snapshot or the log is corrupt.
+     */
+    bool Recover(FAbility& OutAbility) const
+    {
+        OutAbility = FAbility();
+        if (Snapshot.Num() > 0 && !AbilitySaveFormat::LoadFromBytes(Snapshot, OutAbility))
+        {
+            return false;
+        }
+        return Replay(Log, OutAbility);
+    }
+
+    // Applies log entries to the ability in order. Returns false on a malformed entry.
+    static bool Replay(TConstArrayView<uint8> Entries, FAbility& Ability)
+    {
+        int32 Offset = 0;
+        while (Offset < Entries.Num())
+        {
+            const int32 Size = EntrySize(Entries, Offset);
+            if (Size == 0)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Malformed ability journal entry at offset %d."), Offset);
+                return false;
+            }
+
+            const uint8* Entry = Entries.GetData() + Offset;
+            if (static_cast<EAbilityJournalOp>(Entry[0]) == EAbilityJournalOp::Module)
+            {
+                // Modules of categories or types this build does not know are skipped.
+                if (FAbilityModule* Module = Ability.FindModule(static_cast<EAbilityCategory>(Entry[1]), Entry[2]))
+                {
+                    AbilitySaveFormat::UnpackModule(Entry + 3, *Module);
+                }
+            }
+            else if (static_cast<EAbilityJournalOp>(Entry[0]) == EAbilityJournalOp::Respec)
+            {
+                Ability.ResetAllAbilities();
+            }
+            else
+            {
+                int32 Pool[3];
+                FMemory::Memcpy(Pool, Entry + 1, sizeof(Pool));
+                Ability.SetAbilityPoints(Pool[0]);
+                Ability.SetMaxAbilityPoints(Pool[1]);
+                Ability.SetAllocatedPoints(Pool[2]);
+            }
+            Offset += Size;
+        }
+        return true;
+    }
+
+    // Compact snapshot bytes the log applies to.
+    const TArray<uint8>& GetSnapshot() const { return Snapshot; }
+
+    // Log bytes appended since the last compaction; storage can flush the tail it has not written yet.
+    const TArray<uint8>& GetLog() const { return Log; }
+
+    // Number of entries in the log.
+    int32 GetNumEntries() const { return NumEntries; }
+
+private:
+    // Size of the entry at the given offset, or 0 if it is malformed or truncated.
+    static int32 EntrySize(TConstArrayView<uint8> Entries, int32 Offset)
+    {
+        int32 Size = 0;
+        switch (static_cast<EAbilityJournalOp>(Entries[Offset]))
+        {
+        case EAbilityJournalOp::Module: Size = 3 + AbilitySaveFormat::RecordSize; break;
+        case EAbilityJournalOp::Pool:   Size = 1 + 3 * sizeof(int32); break;
+        case EAbilityJournalOp::Respec: Size = 1; break;
+        default:                        return 0;
+        }
+        return Offset + Size <= Entries.Num() ? Size : 0;
+    }
+
+    // Counts the entries of a log, stopping at the first malformed one.
+    static int32 CountEntries(TConstArrayView<uint8> Entries)
+    {
+        int32 Count = 0;
+        for (int32 Offset = 0, Size = 0; Offset < Entries.Num() && (Size = EntrySize(Entries, Offset)) > 0; Offset += Size)
+        {
+            ++Count;
+        }
+        return Count;
+    }
+
+    // Compact save of the state at the last compaction.
+    TArray<uint8> Snapshot;
+
+    // Entries appended since the last compaction.
+    TArray<uint8> Log;
+
+    // Number of entries in Log.
+    int32 NumEntries = 0;
+
+    // Entries after which compaction is due.
+    int32 CompactionThreshold = DefaultCompactionThreshold;
+};
@@ -0,0 +1,373 @@
+#pragma once
+
+#include "AbilitySaveFormat.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+
+/**
+ * Fixed-stride progression file for bulk hydration of many characters.
+ *
+ * Layout:
+ *   Header : FAbilityProgressionFileHeader (32 bytes)
+ *   Record : CharacterId (uint64), AbilityPoints, MaxAbilityPoints, AllocatedPoints (int32 each),
+ *            then ModuleCounts[Category] packed module records per category in EAbilityCategory order,
+ *            zero padded to RecordStride
+ *
+ * Records are sorted by CharacterId. The file is meant to be memory mapped: record views read straight
+ * out of the mapping and a full FAbility is only materialized when a character actually logs in.
+ * Module counts are stored in the header, so files written before enum entries were appended still
+ * read correctly; the missing modules report their defaults.
+ */
+struct FAbilityProgressionFileHeader
+{
+    // Identifies a progression file ("ABLP").
+    static constexpr uint32 ExpectedMagic = 0x41424C50;
+
+    // Current file version.
+    static constexpr uint16 CurrentVersion = 1;
+
+    // Maximum number of categories the header can describe.
+    static constexpr int32 MaxCategories = 14;
+
+    uint32 Magic = ExpectedMagic;
+    uint16 Version = CurrentVersion;
+    uint16 HeaderSize = sizeof(FAbilityProgressionFileHeader);
+    uint32 RecordStride = 0;
+    uint32 NumRecords = 0;
+    uint8 CategoryCount = 0;
+    uint8 RecordSize = AbilitySaveFormat::RecordSize;
+    uint8 ModuleCounts[MaxCategories] = {};
+};
+static_assert(sizeof(FAbilityProgressionFileHeader) == 32, "Progression file header must stay 32 bytes");
+static_assert(static_cast<int32>(EAbilityCategory::Max) - 1 <= FAbilityProgressionFileHeader::MaxCategories, "Too many ability categories for the progression file header");
+
+
+/*
+ * Record offsets derived once from a file header.
+ */
+struct FAbilityProgressionFileLayout
+{
+    // Bytes before the first module record: id and pool.
+    static constexpr uint32 FixedSize = sizeof(uint64) + 3 * sizeof(int32);
+
+    uint32 RecordStride = 0;
+
+    // Bytes of a record before padding: id, pool and every module record.
+    uint32 UsedRecordSize = 0;
+
+    uint8 RecordSize = AbilitySaveFormat::RecordSize;
+    uint8 ModuleCounts[FAbilityProgressionFileHeader::MaxCategories] = {};
+    uint32 CategoryOffsets[FAbilityProgressionFileHeader::MaxCategories] = {};
+
+    // Layout used by this build when writing.
+    static FAbilityProgressionFileLayout MakeCurrent()
+    {
+        FAbilityProgressionFileHeader Header;
+        Header.CategoryCount = static_cast<uint8>(EAbilityCategory::Max) - 1;
+        Header.ModuleCounts[static_cast<uint8>(EAbilityCategory::Martial) - 1] = static_cast<uint8>(EMartialAbilityType::Max) - 1;
+        Header.ModuleCounts[static_cast<uint8>(EAbilityCategory::Magical) - 1] = static_cast<uint8>(EMagicalAbilityType::Max) - 1;
+        Header.ModuleCounts[static_cast<uint8>(EAbilityCategory::Crafting) - 1] = static_cast<uint8>(ECraftingAbilityType::Max) - 1;
+        Header.ModuleCounts[static_cast<uint8>(EAbilityCategory::Survival) - 1] = static_cast<uint8>(ESurvivalAbilityType::Max) - 1;
+        Header.ModuleCounts[static_cast<uint8>(EAbilityCategory::Stealth) - 1] = static_cast<uint8>(EStealthAbilityType::Max) - 1;
+        return FromHeader(Header);
+    }
+
+    // Layout described by a file header. A header without a stride gets the padded record size.
+    static FAbilityProgressionFileLayout FromHeader(const FAbilityProgressionFileHeader& Header)
+    {
+        FAbilityProgressionFileLayout Layout;
+        Layout.RecordSize = Header.RecordSize;
+        uint32 Offset = FixedSize;
+        for (int32 Category = 0; Category < FMath::Min<int32>(Header.CategoryCount, FAbilityProgressionFileHeader::MaxCategories); ++Category)
+        {
+            Layout.ModuleCounts[Category] = Header.ModuleCounts[Category];
+            Layout.CategoryOffsets[Category] = Offset;
+            Offset += Header.ModuleCounts[Category] * Header.RecordSize;
+        }
+        Layout.UsedRecordSize = Offset;
+        Layout.RecordStride = Header.RecordStride ? Header.RecordStride : Align(Offset, 8);
+        return Layout;
+    }
+
+    // Offset of a module record inside a character record, or INDEX_NONE if the file does not store it.
+    int32 GetModuleOffset(EAbilityCategory Category, uint8 Type) const
+    {
+        const int32 CategoryIndex = static_cast<int32>(Category) - 1;
+        if (CategoryIndex < 0 || CategoryIndex >= FAbilityProgressionFileHeader::MaxCategories || Type == 0 || Type > ModuleCounts[CategoryIndex])
+        {
+            return INDEX_NONE;
+        }
+        return static_cast<int32>(CategoryOffsets[CategoryIndex] + (Type - 1) * RecordSize);
+    }
+};
+
+
+/*
+ * Read-only view of one character record inside a mapped progression file.
+ * Valid as long as the file that produced it stays open.
+ */
+struct FAbilityProgressionRecordView
+{
+    const uint8* Data = nullptr;
+    const FAbilityProgressionFileLayout* Layout = nullptr;
+
+    bool IsValid() const { return Data != nullptr; }
+
+    // Character this record belongs to.
+    uint64 GetCharacterId() const { return ReadValue<uint64>(0); }
+
+    int32 GetAbilityPoints() const { return ReadValue<int32>(sizeof(uint64)); }
+    int32 GetMaxAbilityPoints() const { return ReadValue<int32>(sizeof(uint64) + sizeof(int32)); }
+    int32 GetAllocatedPoints() const { return ReadValue<int32>(sizeof(uint64) + 2 * sizeof(int32)); }
+
+    // Reads a module in place. Modules the file does not store report their defaults and return false.
+    bool GetModule(EAbilityCategory Category, uint8 Type, FAbilityModule& OutModule) const
+    {
+        const int32 Offset = Layout->GetModuleOffset(Category, Type);
+        if (Offset == INDEX_NONE)
+        {
+            OutModule = FAbilityModule();
+            return false;
+        }
+        AbilitySaveFormat::UnpackModule(Data + Offset, OutModule);
+        return true;
+    }
+
+    // Builds a full FAbility from the record.
+    void Materialize(FAbility& OutAbility) const
+    {
+        OutAbility.SetAbilityPoints(GetAbilityPoints());
+        OutAbility.SetMaxAbilityPoints(GetMaxAbilityPoints());
+        OutAbility.SetAllocatedPoints(GetAllocatedPoints());
+        MaterializeCategory(EAbilityCategory::Martial, OutAbility.GetMartialAbilities());
+        MaterializeCategory(EAbilityCategory::Magical, OutAbility.GetMagicalAbilities());
+        MaterializeCategory(EAbilityCategory::Crafting, OutAbility.GetCraftingAbilities());
+        MaterializeCategory(EAbilityCategory::Survival, OutAbility.GetSurvivalAbilities());
+        MaterializeCategory(EAbilityCategory::Stealth, OutAbility.GetStealthAbilities());
+    }
+
+private:
+    template<typename ValueType>
+    ValueType ReadValue(uint32 Offset) const
+    {
+        ValueType Value;
+        FMemory::Memcpy(&Value, Data + Offset, sizeof(ValueType));
+        return Value;
+    }
+
+    template<typename AbilityType>
+    void MaterializeCategory(EAbilityCategory Category, TMap<AbilityType, FAbilityModule>& Abilities) const
+    {
+        for (uint8 i = static_cast<uint8>(AbilityType::Null) + 1; i < static_cast<uint8>(AbilityType::Max); ++i)
+        {
+            GetModule(Category, i, Abilities.FindOrAdd(static_cast<AbilityType>(i)));
+        }
+    }
+};
+
+
+/*
+ * Builds a progression file from in-memory abilities.
+ */
+class FAbilityProgressionFileWriter
+{
+public:
+    FAbilityProgressionFileWriter()
+        : Layout(FAbilityProgressionFileLayout::MakeCurrent())
+    {
+    }
+
+    // Reserves space for the given number of characters.
+    void Reserve(int32 NumCharacters)
+    {
+        Records.Reserve(NumCharacters * Layout.RecordStride);
+        CharacterIds.Reserve(NumCharacters);
+    }
+
+    // Appends the record of one character.
+    void Add(uint64 CharacterId, const FAbility& Ability)
+    {
+        const int32 Offset = Records.AddZeroed(Layout.RecordStride);
+        uint8* Record = Records.GetData() + Offset;
+
+        const int32 Pool[3] = { Ability.GetAbilityPoints(), Ability.GetMaxAbilityPoints(), Ability.GetAllocatedPoints() };
+        FMemory::Memcpy(Record, &CharacterId, sizeof(CharacterId));
+        FMemory::Memcpy(Record + sizeof(CharacterId), Pool, sizeof(Pool));
+
+        WriteCategory<EMartialAbilityType>(Record, EAbilityCategory::Martial, Ability);
+        WriteCategory<EMagicalAbilityType>(Record, EAbilityCategory::Magical, Ability);
+        WriteCategory<ECraftingAbilityType>(Record, EAbilityCategory::Crafting, Ability);
+        WriteCategory<ESurvivalAbilityType>(Record, EAbilityCategory::Survival, Ability);
+        WriteCategory<EStealthAbilityType>(Record, EAbilityCategory::Stealth, Ability);
+        CharacterIds.Add(CharacterId);
+    }
+
+    // Sorts records by character id and writes the file. Returns false on I/O failure.
+    bool Save(const TCHAR* Filename) const
+    {
+        const int32 NumRecords = CharacterIds.Num();
+        TArray<int32> Order;
+        Order.SetNumUninitialized(NumRecords);
+        for (int32 Index = 0; Index < NumRecords; ++Index)
+        {
+            Order[Index] = Index;
+        }
+        Order.Sort([this](int32 A, int32 B) { return CharacterIds[A] < CharacterIds[B]; });
+
+        FAbilityProgressionFileHeader Header;
+        Header.RecordStride = Layout.RecordStride;
+        Header.NumRecords = static_cast<uint32>(NumRecords);
+        Header.CategoryCount = static_cast<uint8>(EAbilityCategory::Max) - 1;
+        FMemory::Memcpy(Header.ModuleCounts, Layout.ModuleCounts, sizeof(Header.ModuleCounts));
+
+        TArray<uint8> Bytes;
+        Bytes.SetNumUninitialized(sizeof(Header) + Records.Num());
+        FMemory::Memcpy(Bytes.GetData(), &Header, sizeof(Header));
+        for (int32 Index = 0; Index < NumRecords; ++Index)
+        {
+            FMemory::Memcpy(Bytes.GetData() + sizeof(Header) + Index * Layout.RecordStride, Records.GetData() + Order[Index] * Layout.RecordStride, Layout.RecordStride);
+        }
+        return FFileHelper::SaveArrayToFile(Bytes, Filename);
+    }
+
+private:
+    // Packs every module of one category. Modules are read through FAbility::FindModule, so a
+    // pending respec is written as applied.
+    template<typename AbilityType>
+    void WriteCategory(uint8* Record, EAbilityCategory Category, const FAbility& Ability) const
+    {
+        for (uint8 i = static_cast<uint8>(AbilityType::Null) + 1; i < static_cast<uint8>(AbilityType::Max); ++i)
+        {
+            const FAbilityModule* Module = Ability.FindModule(Category, i);
+            const int32 Offset = Layout.GetModuleOffset(Category, i);
+            if (Module && Offset != INDEX_NONE)
+            {
+                AbilitySaveFormat::PackModule(*Module, Record + Offset);
+            }
+        }
+    }
+
+    FAbilityProgressionFileLayout Layout;
+    TArray<uint8> Records;
+    TArray<uint64> CharacterIds;
+};
+
+
+/*
+ * Memory-mapped, read-only progression file.
+ */
+class FAbilityProgressionFile
+{
+public:
+    FAbilityProgressionFile() = default;
+    FAbilityProgressionFile(const FAbilityProgressionFile&) = delete;
+    FAbilityProgressionFile& operator=(const FAbilityProgressionFile&) = delete;
+
+    ~FAbilityProgressionFile()
+    {
+        Close();
+    }
+
+    // Maps the file and validates its header. Returns false if it cannot be mapped or is not a progression file.
+    bool Open(const TCHAR* Filename)
+    {
+        Close();
+
+        Handle = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(Filename);
+        if (!Handle || Handle->GetFileSize() < static_cast<int64>(sizeof(FAbilityProgressionFileHeader)))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Unable to map progression file %s."), Filename);
+            Close();
+            return false;
+        }
+
+        Region = Handle->MapRegion(0, Handle->GetFileSize());
+        if (!Region)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Unable to map progression file %s."), Filename);
+            Close();
+            return false;
+        }
+
+        FAbilityProgressionFileHeader Header;
+        FMemory::Memcpy(&Header, Region->GetMappedPtr(), sizeof(Header));
+        if (Header.Magic != FAbilityProgressionFileHeader::ExpectedMagic
+            || Header.HeaderSize < sizeof(FAbilityProgressionFileHeader)
+            || Header.RecordSize < AbilitySaveFormat::RecordSize
+            || Header.RecordStride == 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Invalid progression file %s."), Filename);
+            Close();
+            return false;
+        }
+
+        // Every record must hold the layout the header describes, and the mapping every record.
+        const FAbilityProgressionFileLayout FileLayout = FAbilityProgressionFileLayout::FromHeader(Header);
+        const int64 ExpectedSize = Header.HeaderSize + static_cast<int64>(Header.NumRecords) * FileLayout.RecordStride;
+        if (FileLayout.RecordStride < FileLayout.UsedRecordSize || Region->GetMappedSize() < ExpectedSize)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Invalid progression file %s."), Filename);
+            Close();
+            return false;
+        }
+
+        Layout = FileLayout;
+        Records = Region->GetMappedPtr() + Header.HeaderSize;
+        NumRecords = static_cast<int32>(Header.NumRecords);
+        return true;
+    }
+
+    // Unmaps the file; record views taken from it become invalid.
+    void Close()
+    {
+        delete Region;
+        delete Handle;
+        Region = nullptr;
+        Handle = nullptr;
+        Records = nullptr;
+        NumRecords = 0;
+    }
+
+    int32 Num() const { return NumRecords; }
+
+    // View of the record at the given index.
+    FAbilityProgressionRecordView GetRecord(int32 Index) const
+    {
+        check(Index >= 0 && Index < NumRecords);
+        return FAbilityProgressionRecordView{ Records + static_cast<int64>(Index) * Layout.RecordStride, &Layout };
+    }
+
+    // Binary searches the record of a character. Returns an invalid view if it is not in the file.
+    FAbilityProgressionRecordView FindRecord(uint64 CharacterId) const
+    {
+        int32 Low = 0;
+        int32 High = NumRecords;
+        while (Low < High)
+        {
+            const int32 Mid = Low + (High - Low) / 2;
+            const FAbilityProgressionRecordView Record = GetRecord(Mid);
+            const uint64 MidId = Record.GetCharacterId();
+            if (MidId == CharacterId)
+            {
+                return Record;
+            }
+            if (MidId < CharacterId)
+            {
+                Low = Mid + 1;
+            }
+            else
+            {
+                High = Mid;
+            }
+        }
+        return FAbilityProgressionRecordView();
+    }
+
+private:
+    IMappedFileHandle* Handle = nullptr;
+    IMappedFileRegion* Region = nullptr;
+    const uint8* Records = nullptr;
+    int32 NumRecords = 0;
+    FAbilityProgressionFileLayout Layout;
+};
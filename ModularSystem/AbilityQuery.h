@@ -0,0 +1,58 @@
+#pragma once
+
+#include "AbilityData.h"
+
+/**
+ * Progression queries shared by every representation of a character's abilities.
+ *
+ * A source is anything exposing
+ *     bool GetModule(EAbilityCategory Category, uint8 Type, FAbilityModule& OutModule) const
+ * which includes FAbility, FAbilitySaveView (compact save buffers) and FAbilityProgressionRecordView
+ * (mapped progression files). Because the predicates below are written once against that single
+ * accessor, a query returns the same answer whether it runs on live state or on serialized bytes.
+ */
+namespace AbilityQuery
+{
+    // Returns true if the module is unlocked.
+    template<typename SourceType>
+    bool IsUnlocked(const SourceType& Source, EAbilityCategory Category, uint8 Type)
+    {
+        FAbilityModule Module;
+        Source.GetModule(Category, Type, Module);
+        return Module.bUnlocked;
+    }
+
+    // Returns the active points of the module, or 0 if it does not exist.
+    template<typename SourceType>
+    int8 GetPoint(const SourceType& Source, EAbilityCategory Category, uint8 Type)
+    {
+        FAbilityModule Module;
+        Source.GetModule(Category, Type, Module);
+        return Module.Point;
+    }
+
+    // Returns true if the module is unlocked with at least the given active points.
+    template<typename SourceType>
+    bool IsUnlockedAtLeast(const SourceType& Source, EAbilityCategory Category, uint8 Type, int8 MinPoint)
+    {
+        FAbilityModule Module;
+        Source.GetModule(Category, Type, Module);
+        return Module.bUnlocked && Module.Point >= MinPoint;
+    }
+
+    // Typed convenience overloads, e.g. IsUnlockedAtLeast(View, EStealthAbilityType::Lockpicking, 3).
+    template<typename SourceType>
+    bool IsUnlockedAtLeast(const SourceType& Source, EMartialAbilityType Type, int8 MinPoint) { return IsUnlockedAtLeast(Source, EAbilityCategory::Martial, static_cast<uint8>(Type), MinPoint); }
+
+    template<typename SourceType>
+    bool IsUnlockedAtLeast(const SourceType& Source, EMagicalAbilityType Type, int8 MinPoint) { return IsUnlockedAtLeast(Source, EAbilityCategory::Magical, static_cast<uint8>(Type), MinPoint); }
+
+    template<typename SourceType>
+    bool IsUnlockedAtLeast(const SourceType& Source, ECraftingAbilityType Type, int8 MinPoint) { return IsUnlockedAtLeast(Source, EAbilityCategory::Crafting, static_cast<uint8>(Type), MinPoint); }
+
+    template<typename SourceType>
+    bool IsUnlockedAtLeast(const SourceType& Source, ESurvivalAbilityType Type, int8 MinPoint) { return IsUnlockedAtLeast(Source, EAbilityCategory::Survival, static_cast<uint8>(Type), MinPoint); }
+
+    template<typename SourceType>
+    bool IsUnlockedAtLeast(const SourceType& Source, EStealthAbilityType Type, int8 MinPoint) { return IsUnlockedAtLeast(Source, EAbilityCategory::Stealth, static_cast<uint8>(Type), MinPoint); }
+}
@@ -0,0 +1,305 @@
+#pragma once
+
+#include "AbilityData.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/**
+ * Compact, versioned binary save format for FAbility.
+ *
+ * Layout (little endian):
+ *   Header   : Magic (uint32), Version (uint8), CategoryCount (uint8), RecordSize (uint8)
+ *   Pool     : AbilityPoints, MaxAbilityPoints, AllocatedPoints as packed unsigned ints
+ *   Category : ModuleCount (uint8) followed by ModuleCount records, one per enum value after Null in enum order
+ *   Record   : (bUnlocked << 7 | Point), MaxPoint, AllocatedPoint, followed by RecordSize - 3 bytes reserved for later versions
+ *
+ * Enum entries appended before Max stay compatible in both directions: records beyond the
+ * current enum range are skipped on load, and modules missing from an older save keep their
+ * defaults. Categories appended to EAbilityCategory are handled the same way.
+ *
+ * Save and load are one linear pass over the categories. Loading writes into the modules the
+ * FAbility constructor already created, so no map grows or rehashes.
+ */
+namespace AbilitySaveFormat
+{
+    // Identifies a compact ability save ("ABLT").
+    constexpr uint32 Magic = 0x41424C54;
+
+    // Current format version.
+    constexpr uint8 Version = 1;
+
+    // Bytes written per module record by this version.
+    constexpr uint8 RecordSize = 3;
+
+    // Packs a module into a RecordSize-byte record.
+    inline void PackModule(const FAbilityModule& Module, uint8* OutRecord)
+    {
+        OutRecord[0] = static_cast<uint8>((Module.bUnlocked ? 0x80 : 0) | (Module.Point & 0x7F));
+        OutRecord[1] = static_cast<uint8>(Module.MaxPoint);
+        OutRecord[2] = static_cast<uint8>(Module.AllocatedPoint);
+    }
+
+    // Restores a module from a packed record.
+    inline void UnpackModule(const uint8* Record, FAbilityModule& OutModule)
+    {
+        OutModule.bUnlocked = (Record[0] & 0x80) != 0;
+        OutModule.Point = static_cast<int8>(Record[0] & 0x7F);
+        OutModule.MaxPoint = static_cast<int8>(Record[1]);
+        OutModule.AllocatedPoint = static_cast<int8>(Record[2]);
+    }
+
+    // Writes every module of one category as a count followed by packed records.
+    // Modules are read through FAbility::FindModule, so a pending respec is saved as applied.
+    template<typename AbilityType>
+    void SaveCategory(FArchive& Ar, const FAbility& Ability, EAbilityCategory Category)
+    {
+        uint8 Count = static_cast<uint8>(static_cast<uint8>(AbilityType::Max) - 1);
+        Ar << Count;
+
+        for (uint8 i = static_cast<uint8>(AbilityType::Null) + 1; i < static_cast<uint8>(AbilityType::Max); ++i)
+        {
+            const FAbilityModule* Module = Ability.FindModule(Category, i);
+            const FAbilityModule Default;
+            const FAbilityModule& Source = Module ? *Module : Default;
+
+            uint8 Record[RecordSize];
+            PackModule(Source, Record);
+            Ar.Serialize(Record, RecordSize);
+        }
+    }
+
+    // Checks that the next Count records are inside the archive; flags the archive as failed if not.
+    inline bool HasRecords(FArchive& Ar, uint8 Count, uint8 StoredRecordSize)
+    {
+        if (Ar.IsError() || Ar.Tell() + static_cast<int64>(Count) * StoredRecordSize > Ar.TotalSize())
+        {
+            Ar.SetError();
+            return false;
+        }
+        return true;
+    }
+
+    // Reads one category written by any version, skipping records this build does not know about.
+    // Returns false if the archive ends before the category does.
+    template<typename AbilityType>
+    bool LoadCategory(FArchive& Ar, TMap<AbilityType, FAbilityModule>& Abilities, uint8 StoredRecordSize)
+    {
+        uint8 Count = 0;
+        Ar << Count;
+        if (!HasRecords(Ar, Count, StoredRecordSize))
+        {
+            return false;
+        }
+
+        for (uint8 i = 0; i < Count && !Ar.IsError(); ++i)
+        {
+            uint8 Record[RecordSize];
+            Ar.Serialize(Record, RecordSize);
+            if (StoredRecordSize > RecordSize)
+            {
+                Ar.Seek(Ar.Tell() + (StoredRecordSize - RecordSize));
+            }
+
+            const uint8 Type = i + 1;
+            if (Type >= static_cast<uint8>(AbilityType::Max))
+            {
+                continue;
+            }
+
+            UnpackModule(Record, Abilities.FindOrAdd(static_cast<AbilityType>(Type)));
+        }
+        return !Ar.IsError();
+    }
+
+    // Skips one category this build does not know about. Returns false if the archive ends before the category does.
+    inline bool SkipCategory(FArchive& Ar, uint8 StoredRecordSize)
+    {
+        uint8 Count = 0;
+        Ar << Count;
+        if (!HasRecords(Ar, Count, StoredRecordSize))
+        {
+            return false;
+        }
+        Ar.Seek(Ar.Tell() + static_cast<int64>(Count) * StoredRecordSize);
+        return true;
+    }
+
+    // Writes the ability in the compact format.
+    inline void Save(FArchive& Ar, const FAbility& Ability)
+    {
+        ABILITY_SCOPE_OPERATION(Serialize, EAbilityCategory::Null, 0);
+        check(Ar.IsSaving());
+
+        uint32 HeaderMagic = Magic;
+        uint8 HeaderVersion = Version;
+        uint8 CategoryCount = static_cast<uint8>(EAbilityCategory::Max) - 1;
+        uint8 HeaderRecordSize = RecordSize;
+        Ar << HeaderMagic << HeaderVersion << CategoryCount << HeaderRecordSize;
+
+        uint32 AbilityPoints = static_cast<uint32>(Ability.GetAbilityPoints());
+        uint32 MaxAbilityPoints = static_cast<uint32>(Ability.GetMaxAbilityPoints());
+        uint32 AllocatedPoints = static_cast<uint32>(Ability.GetAllocatedPoints());
+        Ar.SerializeIntPacked(AbilityPoints);
+        Ar.SerializeIntPacked(MaxAbilityPoints);
+        Ar.SerializeIntPacked(AllocatedPoints);
+
+        // Must follow EAbilityCategory order.
+        SaveCategory<EMartialAbilityType>(Ar, Ability, EAbilityCategory::Martial);
+        SaveCategory<EMagicalAbilityType>(Ar, Ability, EAbilityCategory::Magical);
+        SaveCategory<ECraftingAbilityType>(Ar, Ability, EAbilityCategory::Crafting);
+        SaveCategory<ESurvivalAbilityType>(Ar, Ability, EAbilityCategory::Survival);
+        SaveCategory<EStealthAbilityType>(Ar, Ability, EAbilityCategory::Stealth);
+    }
+
+    // Reads an ability written in the compact format. Returns false, leaving Ability untouched, if
+    // the data is not a valid save.
+    inline bool Load(FArchive& Ar, FAbility& Ability)
+    {
+        ABILITY_SCOPE_OPERATION(Serialize, EAbilityCategory::Null, 0);
+        check(Ar.IsLoading());
+
+        uint32 HeaderMagic = 0;
+        uint8 HeaderVersion = 0;
+        uint8 CategoryCount = 0;
+        uint8 StoredRecordSize = 0;
+        Ar << HeaderMagic << HeaderVersion << CategoryCount << StoredRecordSize;
+        if (Ar.IsError() || HeaderMagic != Magic || HeaderVersion == 0 || StoredRecordSize < RecordSize)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Invalid compact ability save header."));
+            return false;
+        }
+
+        uint32 AbilityPoints = 0;
+        uint32 MaxAbilityPoints = 0;
+        uint32 AllocatedPoints = 0;
+        Ar.SerializeIntPacked(AbilityPoints);
+        Ar.SerializeIntPacked(MaxAbilityPoints);
+        Ar.SerializeIntPacked(AllocatedPoints);
+
+        // Decode into a fresh ability so a failed load leaves the caller's ability as it was.
+        FAbility Decoded;
+        Decoded.SetAbilityPoints(static_cast<int32>(AbilityPoints));
+        Decoded.SetMaxAbilityPoints(static_cast<int32>(MaxAbilityPoints));
+        Decoded.SetAllocatedPoints(static_cast<int32>(AllocatedPoints));
+
+        bool bLoaded = !Ar.IsError();
+        for (uint8 Category = 1; Category <= CategoryCount && bLoaded; ++Category)
+        {
+            switch (static_cast<EAbilityCategory>(Category))
+            {
+            case EAbilityCategory::Martial:  bLoaded = LoadCategory(Ar, Decoded.GetMartialAbilities(), StoredRecordSize); break;
+            case EAbilityCategory::Magical:  bLoaded = LoadCategory(Ar, Decoded.GetMagicalAbilities(), StoredRecordSize); break;
+            case EAbilityCategory::Crafting: bLoaded = LoadCategory(Ar, Decoded.GetCraftingAbilities(), StoredRecordSize); break;
+            case EAbilityCategory::Survival: bLoaded = LoadCategory(Ar, Decoded.GetSurvivalAbilities(), StoredRecordSize); break;
+            case EAbilityCategory::Stealth:  bLoaded = LoadCategory(Ar, Decoded.GetStealthAbilities(), StoredRecordSize); break;
+            default:                         bLoaded = SkipCategory(Ar, StoredRecordSize); break;
+            }
+        }
+
+        if (!bLoaded || Ar.IsError())
+        {
+            UE_LOG(LogTemp, Error, TEXT("Truncated compact ability save."));
+            return false;
+        }
+        Ability = MoveTemp(Decoded);
+        return true;
+    }
+
+    // Writes the ability into a byte buffer.
+    inline void SaveToBytes(const FAbility& Ability, TArray<uint8>& OutBytes)
+    {
+        FMemoryWriter Writer(OutBytes);
+        Save(Writer, Ability);
+    }
+
+    // Reads the ability from a byte buffer. Returns false if the buffer is not a valid save.
+    inline bool LoadFromBytes(TConstArrayView<uint8> Bytes, FAbility& Ability)
+    {
+        FMemoryReaderView Reader(Bytes);
+        return Load(Reader, Ability);
+    }
+}
+
+
+/*
+ * Read-only view over a compact ability save.
+ * Parses the header once and then answers module and pool queries straight from the buffer,
+ * without deserializing or allocating. The buffer must outlive the view.
+ */
+struct FAbilitySaveView
+{
+    // Parses the header of a compact save. Returns false if the buffer is not a valid save.
+    bool Initialize(TConstArrayView<uint8> InBytes)
+    {
+        Bytes = InBytes;
+        CategoryCount = 0;
+
+        FMemoryReaderView Reader(Bytes);
+        uint32 HeaderMagic = 0;
+        uint8 HeaderVersion = 0;
+        uint8 StoredCategoryCount = 0;
+        Reader << HeaderMagic << HeaderVersion << StoredCategoryCount << StoredRecordSize;
+        if (Reader.IsError() || HeaderMagic != AbilitySaveFormat::Magic || HeaderVersion == 0 || StoredRecordSize < AbilitySaveFormat::RecordSize)
+        {
+            return false;
+        }
+
+        uint32 Pool[3] = {};
+        Reader.SerializeIntPacked(Pool[0]);
+        Reader.SerializeIntPacked(Pool[1]);
+        Reader.SerializeIntPacked(Pool[2]);
+        AbilityPoints = static_cast<int32>(Pool[0]);
+        MaxAbilityPoints = static_cast<int32>(Pool[1]);
+        AllocatedPoints = static_cast<int32>(Pool[2]);
+
+        // Record where each category's records start; categories beyond MaxCategories are ignored.
+        int64 Offset = Reader.Tell();
+        const int32 NumCategories = FMath::Min<int32>(StoredCategoryCount, MaxCategories);
+        for (int32 Category = 0; Category < NumCategories; ++Category)
+        {
+            if (Reader.IsError() || Offset >= Bytes.Num())
+            {
+                return false;
+            }
+            ModuleCounts[Category] = Bytes[Offset];
+            CategoryOffsets[Category] = static_cast<uint32>(Offset + 1);
+            Offset += 1 + static_cast<int64>(ModuleCounts[Category]) * StoredRecordSize;
+        }
+        if (Offset > Bytes.Num())
+        {
+            return false;
+        }
+
+        CategoryCount = static_cast<uint8>(NumCategories);
+        return true;
+    }
+
+    int32 GetAbilityPoints() const { return AbilityPoints; }
+    int32 GetMaxAbilityPoints() const { return MaxAbilityPoints; }
+    int32 GetAllocatedPoints() const { return AllocatedPoints; }
+
+    // Reads a module in place. Modules the save does not contain report their defaults and return false.
+    bool GetModule(EAbilityCategory Category, uint8 Type, FAbilityModule& OutModule) const
+    {
+        const int32 CategoryIndex = static_cast<int32>(Category) - 1;
+        if (CategoryIndex < 0 || CategoryIndex >= CategoryCount || Type == 0 || Type > ModuleCounts[CategoryIndex])
+        {
+            OutModule = FAbilityModule();
+            return false;
+        }
+        AbilitySaveFormat::UnpackModule(Bytes.GetData() + CategoryOffsets[CategoryIndex] + (Type - 1) * StoredRecordSize, OutModule);
+        return true;
+    }
+
+private:
+    static constexpr int32 MaxCategories = 16;
+
+    TConstArrayView<uint8> Bytes;
+    int32 AbilityPoints = 0;
+    int32 MaxAbilityPoints = 0;
+    int32 AllocatedPoints = 0;
+    uint8 StoredRecordSize = 0;
+    uint8 CategoryCount = 0;
+    uint8 ModuleCounts[MaxCategories] = {};
+    uint32 CategoryOffsets[MaxCategories] = {};
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "AbilityData.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+/**
+ * Compressed codec for archived FAbility snapshots.
+ *
+ * Most archived modules are untouched, so only modules that differ from a base are written:
+ * the default module for a full snapshot, or the same module of the previous snapshot for a
+ * delta snapshot. Everything is bit packed.
+ *
+ * Stream:
+ *   Version (8 bits), bDelta (1 bit)
+ *   bPoolChanged (1 bit) and, if set, AbilityPoints, MaxAbilityPoints, AllocatedPoints as packed ints
+ *   EntryCount (packed int)
+ *   Entry: Category (3 bits), Type (5 bits), bWide (1 bit),
+ *          bUnlocked (1 bit), Point, MaxPoint, AllocatedPoint (4 bits each, 8 bits each when bWide)
+ *
+ * Entries address modules by category and type, so snapshots stay decodable after enum entries
+ * are appended; modules unknown to the decoding build are skipped.
+ */
+namespace AbilitySnapshotCodec
+{
+    // Current stream version.
+    constexpr uint8 Version = 1;
+
+    constexpr int32 CategoryBits = 3;
+    constexpr int32 TypeBits = 5;
+    constexpr int32 NarrowBits = 4;
+    constexpr int32 WideBits = 8;
+
+    static_assert(static_cast<int32>(EAbilityCategory::Max) <= (1 << CategoryBits), "EAbilityCategory does not fit the snapshot codec");
+    static_assert(static_cast<int32>(EMartialAbilityType::Max) <= (1 << TypeBits), "EMartialAbilityType does not fit the snapshot codec");
+    static_assert(static_cast<int32>(EMagicalAbilityType::Max) <= (1 << TypeBits), "EMagicalAbilityType does not fit the snapshot codec");
+    static_assert(static_cast<int32>(ECraftingAbilityType::Max) <= (1 << TypeBits), "ECraftingAbilityType does not fit the snapshot codec");
+    static_assert(static_cast<int32>(ESurvivalAbilityType::Max) <= (1 << TypeBits), "ESurvivalAbilityType does not fit the snapshot codec");
+    static_assert(static_cast<int32>(EStealthAbilityType::Max) <= (1 << TypeBits), "EStealthAbilityType does not fit the snapshot codec");
+
+    // Bitwise equality of two modules.
+    inline bool ModulesEqual(const FAbilityModule& A, const FAbilityModule& B)
+    {
+        return A.bUnlocked == B.bUnlocked && A.Point == B.Point && A.MaxPoint == B.MaxPoint && A.AllocatedPoint == B.AllocatedPoint;
+    }
+
+    // Writes one module entry.
+    inline void WriteEntry(FBitWriter& Writer, EAbilityCategory Category, uint8 Type, const FAbilityModule& Module)
+    {
+        uint8 CategoryValue = static_cast<uint8>(Category);
+        Writer.SerializeBits(&CategoryValue, CategoryBits);
+        Writer.SerializeBits(&Type, TypeBits);
+
+        uint8 Fields[3] = { static_cast<uint8>(Module.Point), static_cast<uint8>(Module.MaxPoint), static_cast<uint8>(Module.AllocatedPoint) };
+        const bool bWide = FMath::Max3(Fields[0], Fields[1], Fields[2]) >= (1 << NarrowBits);
+        Writer.WriteBit(bWide ? 1 : 0);
+        Writer.WriteBit(Module.bUnlocked ? 1 : 0);
+        for (uint8& Field : Fields)
+        {
+            Writer.SerializeBits(&Field, bWide ? WideBits : NarrowBits);
+        }
+    }
+
+    // Writes the entries of one category that differ from the base. Modules are read through
+    // FAbility::FindModule, so a pending respec is encoded as applied.
+    template<typename AbilityType>
+    void WriteCategory(FBitWriter& Writer, EAbilityCategory Category, const FAbility& Snapshot, const FAbility* Base, uint32& InOutCount, bool bCountOnly)
+    {
+        for (uint8 i = static_cast<uint8>(AbilityType::Null) + 1; i < static_cast<uint8>(AbilityType::Max); ++i)
+        {
+            const FAbilityModule* Module = Snapshot.FindModule(Category, i);
+            if (!Module)
+            {
+                continue;
+            }
+
+            FAbilityModule BaseModule;
+            if (Base)
+            {
+                Base->GetModule(Category, i, BaseModule);
+            }
+            if (ModulesEqual(*Module, BaseModule))
+            {
+                continue;
+            }
+
+            ++InOutCount;
+            if (!bCountOnly)
+            {
+                WriteEntry(Writer, Category, i, *Module);
+            }
+        }
+    }
+
+    /*
+     * Encodes a snapshot. When Previous is given only modules that changed since it are written,
+     * and decoding needs the same previous snapshot.
+     */
+    inline void Encode(const FAbility& Snapshot, const FAbility* Previous, TArray<uint8>& OutBytes)
+    {
+        ABILITY_SCOPE_OPERATION(Serialize, EAbilityCategory::Null, 0);
+        FBitWriter Writer(0, true);
+
+        uint8 StreamVersion = Version;
+        Writer << StreamVersion;
+        Writer.WriteBit(Previous ? 1 : 0);
+
+        const bool bPoolChanged = !Previous
+            || Snapshot.GetAbilityPoints() != Previous->GetAbilityPoints()
+            || Snapshot.GetMaxAbilityPoints() != Previous->GetMaxAbilityPoints()
+            || Snapshot.GetAllocatedPoints() != Previous->GetAllocatedPoints();
+        Writer.WriteBit(bPoolChanged ? 1 : 0);
+        if (bPoolChanged)
+        {
+            uint32 Pool[3] = { static_cast<uint32>(Snapshot.GetAbilityPoints()), static_cast<uint32>(Snapshot.GetMaxAbilityPoints()), static_cast<uint32>(Snapshot.GetAllocatedPoints()) };
+            Writer.SerializeIntPacked(Pool[0]);
+            Writer.SerializeIntPacked(Pool[1]);
+            Writer.SerializeIntPacked(Pool[2]);
+        }
+
+        // Count first so the decoder knows where the stream ends, then write the entries.
+        for (int32 Pass = 0; Pass < 2; ++Pass)
+        {
+            const bool bCountOnly = Pass == 0;
+            uint32 Count = 0;
+            WriteCategory<EMartialAbilityType>(Writer, EAbilityCategory::Martial, Snapshot, Previous, Count, bCountOnly);
+            WriteCategory<EMagicalAbilityType>(Writer, EAbilityCategory::Magical, Snapshot, Previous, Count, bCountOnly);
+            WriteCategory<ECraftingAbilityType>(Writer, EAbilityCategory::Crafting, Snapshot, Previous, Count, bCountOnly);
+            WriteCategory<ESurvivalAbilityType>(Writer, EAbilityCategory::Survival, Snapshot, Previous, Count, bCountOnly);
+            WriteCategory<EStealthAbilityType>(Writer, EAbilityCategory::Stealth, Snapshot, Previous, Count, bCountOnly);
+            if (bCountOnly)
+            {
+                Writer.SerializeIntPacked(Count);
+            }
+        }
+
+        OutBytes.Reset();
+        OutBytes.Append(Writer.GetData(), Writer.GetNumBytes());
+    }
+
+    /*
+     * Decodes a snapshot. Delta snapshots require the previous snapshot they were encoded against.
+     * Returns false if the stream is malformed or a required previous snapshot is missing.
+     */
+    inline bool Decode(TConstArrayView<uint8> Bytes, const FAbility* Previous, FAbility& OutSnapshot)
+    {
+        ABILITY_SCOPE_OPERATION(Serialize, EAbilityCategory::Null, 0);
+        FBitReader Reader(const_cast<uint8*>(Bytes.GetData()), static_cast<int64>(Bytes.Num()) * 8);
+
+        uint8 StreamVersion = 0;
+        Reader << StreamVersion;
+        const bool bDelta = Reader.ReadBit() != 0;
+        if (Reader.IsError() || StreamVersion == 0 || StreamVersion > Version)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Unsupported ability snapshot version."));
+            return false;
+        }
+        if (bDelta && !Previous)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Delta ability snapshot decoded without its previous snapshot."));
+            return false;
+        }
+
+        OutSnapshot = bDelta ? *Previous : FAbility();
+
+        if (Reader.ReadBit())
+        {
+            uint32 Pool[3] = {};
+            Reader.SerializeIntPacked(Pool[0]);
+            Reader.SerializeIntPacked(Pool[1]);
+            Reader.SerializeIntPacked(Pool[2]);
+            OutSnapshot.SetAbilityPoints(static_cast<int32>(Pool[0]));
+            OutSnapshot.SetMaxAbilityPoints(static_cast<int32>(Pool[1]));
+            OutSnapshot.SetAllocatedPoints(static_cast<int32>(Pool[2]));
+        }
+
+        uint32 Count = 0;
+        Reader.SerializeIntPacked(Count);
+        for (uint32 Index = 0; Index < Count && !Reader.IsError(); ++Index)
+        {
+            uint8 CategoryValue = 0;
+            uint8 Type = 0;
+            Reader.SerializeBits(&CategoryValue, CategoryBits);
+            Reader.SerializeBits(&Type, TypeBits);
+
+            const bool bWide = Reader.ReadBit() != 0;
+            const bool bUnlocked = Reader.ReadBit() != 0;
+            uint8 Fields[3] = {};
+            for (uint8& Field : Fields)
+            {
+                Reader.SerializeBits(&Field, bWide ? WideBits : NarrowBits);
+            }
+
+            // Value fields only: FindModule stamped the current respec generation on the target.
+            if (FAbilityModule* Target = OutSnapshot.FindModule(static_cast<EAbilityCategory>(CategoryValue), Type))
+            {
+                Target->bUnlocked = bUnlocked;
+                Target->Point = static_cast<int8>(Fields[0]);
+                Target->MaxPoint = static_cast<int8>(Fields[1]);
+                Target->AllocatedPoint = static_cast<int8>(Fields[2]);
+            }
+        }
+
+        if (Reader.IsError())
+        {
+            UE_LOG(LogTemp, Error, TEXT("Truncated ability snapshot."));
+            return false;
+        }
+        return true;
+    }
+}
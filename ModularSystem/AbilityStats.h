@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+/**
+ * Instrumentation of ability operations.
+ *
+ * Stat group: "stat Abilities" shows the inclusive time and the call count of every operation.
+ * Both compile out with STATS disabled and cost one thread-local check while the group is not
+ * being collected.
+ *
+ * Trace channel: "Ability" emits one Ability.Operation event per operation with its start and
+ * end cycles, group or category, and type. The channel is off by default; enable it with
+ * -trace=Ability (e.g. "-trace=Ability -tracefile=Ability.utrace" on a headless server) or the
+ * Trace.Enable console command. While it is off, a scope costs a single channel test.
+ */
+DECLARE_STATS_GROUP(TEXT("Abilities"), STATGROUP_Abilities, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Lookup"), STAT_Ability_Lookup, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Unlock"), STAT_Ability_Unlock, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Upgrade"), STAT_Ability_Upgrade, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Validate"), STAT_Ability_Validate, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Activate"), STAT_Ability_Activate, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialize"), STAT_Ability_Serialize, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Progression Lookup"), STAT_Ability_ProgressionLookup, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Progression Change"), STAT_Ability_ProgressionChange, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Allocate"), STAT_Ability_Allocate, STATGROUP_Abilities, YOURGAME_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Lookup Calls"), STAT_Ability_LookupCalls, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Unlock Calls"), STAT_Ability_UnlockCalls, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Upgrade Calls"), STAT_Ability_UpgradeCalls, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Validate Calls"), STAT_Ability_ValidateCalls, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Activate Calls"), STAT_Ability_ActivateCalls, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Serialize Calls"), STAT_Ability_SerializeCalls, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Progression Lookup Calls"), STAT_Ability_ProgressionLookupCalls, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Progression Change Calls"), STAT_Ability_ProgressionChangeCalls, STATGROUP_Abilities, YOURGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Allocate Calls"), STAT_Ability_AllocateCalls, STATGROUP_Abilities, YOURGAME_API);
+
+UE_TRACE_CHANNEL_EXTERN(AbilityChannel, YOURGAME_API);
+
+UE_TRACE_EVENT_BEGIN_EXTERN(Ability, Operation)
+    UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+    UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+    UE_TRACE_EVENT_FIELD(uint8, Op)
+    UE_TRACE_EVENT_FIELD(uint8, Group)
+    UE_TRACE_EVENT_FIELD(uint8, Type)
+UE_TRACE_EVENT_END()
+
+// Operation recorded by an Ability.Operation trace event.
+enum class EAbilityTraceOp : uint8
+{
+    Lookup,
+    Unlock,
+    Upgrade,
+    Validate,
+    Activate,
+    Serialize,
+    ProgressionLookup,
+    ProgressionChange,
+    Allocate,
+    Max
+};
+
+// Emits an Ability.Operation event spanning its lifetime while the Ability channel is enabled.
+class FAbilityTraceScope
+{
+public:
+    // Group is an EAbilityGroup for component operations and an EAbilityCategory for progression operations.
+    // Operations on a whole FAbility pass Null; Allocate passes the batch size as Type.
+    FAbilityTraceScope(EAbilityTraceOp InOp, uint8 InGroup, uint8 InType)
+        : StartCycle(UE_TRACE_CHANNELEXPR_IS_ENABLED(AbilityChannel) ? FPlatformTime::Cycles64() : 0)
+        , Op(InOp)
+        , Group(InGroup)
+        , Type(InType)
+    {
+    }
+
+    ~FAbilityTraceScope()
+    {
+        if (StartCycle != 0)
+        {
+            UE_TRACE_LOG(Ability, Operation, AbilityChannel)
+                << Operation.StartCycle(StartCycle)
+                << Operation.EndCycle(FPlatformTime::Cycles64())
+                << Operation.Op(static_cast<uint8>(Op))
+                << Operation.Group(Group)
+                << Operation.Type(Type);
+        }
+    }
+
+private:
+    uint64 StartCycle;
+    EAbilityTraceOp Op;
+    uint8 Group;
+    uint8 Type;
+};
+
+/*
+ * Instruments the rest of the enclosing scope as one ability operation: times it into the stat
+ * group, counts the call and traces it. Op is one of EAbilityTraceOp.
+ */
+#define ABILITY_SCOPE_OPERATION(Op, Group, Type) \
+    SCOPE_CYCLE_COUNTER(STAT_Ability_##Op); \
+    INC_DWORD_STAT(STAT_Ability_##Op##Calls); \
+    FAbilityTraceScope ANONYMOUS_VARIABLE(AbilityTraceScope)(EAbilityTraceOp::Op, static_cast<uint8>(Group), static_cast<uint8>(Type))
@@ -0,0 +1,852 @@
+#include "AbilityBenchmarkCommandlet.h"
+#include "AbilityBenchmarkComponent.h"
+#include "AbilityBenchmarkUtils.h"
+#include "AbilityComponent.h"
+#include "AbilityEffectSubsystem.h"
+#include "AbilityJournal.h"
+#include "AbilitySnapshotCodec.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/CoreNet.h"
+
+namespace AbilityBenchmark
+{
+    /** Pick a random ability of the given enum, excluding None */
+    template<typename EnumType>
+    EnumType RandomAbility(FRandomStream& Random)
+    {
+        return static_cast<EnumType>(Random.RandRange(1, static_cast<int32>(EnumType::Max) - 1));
+    }
+
+    /** Pick a random progression module address */
+    FAbilityAllocationDelta RandomAllocation(FRandomStream& Random)
+    {
+        FAbilityAllocationDelta Delta;
+        Delta.Category = static_cast<EAbilityCategory>(Random.RandRange(1, static_cast<int32>(EAbilityCategory::Max) - 1));
+        Delta.Type = static_cast<uint8>(Random.RandRange(1, AbilityBuild::NumTypes(Delta.Category)));
+        Delta.Delta = Random.FRand() < 0.75f ? 1 : -1;
+        return Delta;
+    }
+
+    /** Give every module a chance to be progressed, leaving the rest at their defaults */
+    void RandomizeProgression(FAbility& Ability, FRandomStream& Random, float Density)
+    {
+        for (uint8 Category = 1; Category < static_cast<uint8>(EAbilityCategory::Max); ++Category)
+        {
+            for (uint8 Type = 1; Type < 32; ++Type)
+            {
+                FAbilityModule* Module = Ability.FindModule(static_cast<EAbilityCategory>(Category), Type);
+                if (Module && Random.FRand() < Density)
+                {
+                    Module->AllocatedPoint = static_cast<int8>(Random.RandRange(1, Module->MaxPoint));
+                    Module->Point = static_cast<int8>(Random.RandRange(0, Module->AllocatedPoint));
+                    Module->bUnlocked = Module->Point > 0;
+                }
+            }
+        }
+        Ability.SetMaxAbilityPoints(40);
+        Ability.SetAllocatedPoints(Random.RandRange(0, 40));
+        Ability.SetAbilityPoints(Random.RandRange(0, Ability.GetAllocatedPoints()));
+    }
+
+    double CyclesToMs(uint64 Cycles)
+    {
+        return FPlatformTime::ToMilliseconds64(Cycles);
+    }
+
+    /** Access patterns of the micro suite */
+    enum class EAccessPattern : uint8
+    {
+        Hot,
+        Uniform,
+        Sequential,
+        Max
+    };
+
+    const TCHAR* AccessPatternNames[] = { TEXT("Hot"), TEXT("Uniform"), TEXT("Sequential") };
+
+    /** One pre-generated access: an entity of the population, a component slot and a progression module */
+    struct FAccess
+    {
+        int32 Entity = 0;
+        EAbilityGroup Group = EAbilityGroup::Combat;
+        uint8 Ability = 1;
+        EAbilityCategory Category = EAbilityCategory::Martial;
+        uint8 Type = 1;
+    };
+
+    /** Generate an access trace; the hot pattern hits one entity and key, sequential walks entities then keys */
+    void GenerateAccesses(EAccessPattern Pattern, int32 Population, int32 NumOps, FRandomStream& Random, TArray<FAccess>& OutAccesses)
+    {
+        const int32 NumGroups = static_cast<int32>(EAbilityGroup::Max);
+        const int32 NumCategories = static_cast<int32>(EAbilityCategory::Max) - 1;
+
+        OutAccesses.SetNum(NumOps);
+        for (int32 Index = 0; Index < NumOps; ++Index)
+        {
+            FAccess& Access = OutAccesses[Index];
+            Access = FAccess();
+            if (Pattern == EAccessPattern::Uniform)
+            {
+                Access.Entity = Random.RandRange(0, Population - 1);
+                Access.Group = static_cast<EAbilityGroup>(Random.RandRange(0, NumGroups - 1));
+                Access.Ability = static_cast<uint8>(Random.RandRange(1, NumAbilities(Access.Group)));
+                Access.Category = static_cast<EAbilityCategory>(Random.RandRange(1, NumCategories));
+                Access.Type = static_cast<uint8>(Random.RandRange(1, AbilityBuild::NumTypes(Access.Category)));
+            }
+            else if (Pattern == EAccessPattern::Sequential)
+            {
+                const int32 Key = Index / Population;
+                Access.Entity = Index % Population;
+                Access.Group = static_cast<EAbilityGroup>(Key % NumGroups);
+                Access.Ability = static_cast<uint8>(Key / NumGroups % NumAbilities(Access.Group) + 1);
+                Access.Category = static_cast<EAbilityCategory>(Key % NumCategories + 1);
+                Access.Type = static_cast<uint8>(Key / NumCategories % AbilityBuild::NumTypes(Access.Category) + 1);
+            }
+        }
+    }
+
+    /** True if a property with the given lifetime condition replicates to a connection */
+    bool ReplicatesTo(ELifetimeCondition Condition, bool bOwner)
+    {
+        switch (Condition)
+        {
+        case COND_Never:           return false;
+        case COND_OwnerOnly:
+        case COND_AutonomousOnly:  return bOwner;
+        case COND_SkipOwner:
+        case COND_SimulatedOnly:   return !bOwner;
+        default:                   return true;
+        }
+    }
+
+    bool IsUnlocked(const UAbilityComponent& Component, EAbilityGroup Group, uint8 Ability)
+    {
+        switch (Group)
+        {
+        case EAbilityGroup::Combat:   return Component.IsCombatAbilityUnlocked(static_cast<ECombatAbility>(Ability));
+        case EAbilityGroup::Support:  return Component.IsSupportAbilityUnlocked(static_cast<ESupportAbility>(Ability));
+        case EAbilityGroup::Movement: return Component.IsMovementAbilityUnlocked(static_cast<EMovementAbility>(Ability));
+        case EAbilityGroup::Control:  return Component.IsControlAbilityUnlocked(static_cast<EControlAbility>(Ability));
+        default:                      return false;
+        }
+    }
+
+    void Unlock(UAbilityComponent& Component, EAbilityGroup Group, uint8 Ability)
+    {
+        switch (Group)
+        {
+        case EAbilityGroup::Combat:   Component.UnlockCombatAbility(static_cast<ECombatAbility>(Ability)); break;
+        case EAbilityGroup::Support:  Component.UnlockSupportAbility(static_cast<ESupportAbility>(Ability)); break;
+        case EAbilityGroup::Movement: Component.UnlockMovementAbility(static_cast<EMovementAbility>(Ability)); break;
+        case EAbilityGroup::Control:  Component.UnlockControlAbility(static_cast<EControlAbility>(Ability)); break;
+        default:                      break;
+        }
+    }
+
+    void Upgrade(UAbilityComponent& Component, EAbilityGroup Group, uint8 Ability)
+    {
+        switch (Group)
+        {
+        case EAbilityGroup::Combat:   Component.UpgradeCombatAbility(static_cast<ECombatAbility>(Ability)); break;
+        case EAbilityGroup::Support:  Component.UpgradeSupportAbility(static_cast<ESupportAbility>(Ability)); break;
+        case EAbilityGroup::Movement: Component.UpgradeMovementAbility(static_cast<EMovementAbility>(Ability)); break;
+        case EAbilityGroup::Control:  Component.UpgradeControlAbility(static_cast<EControlAbility>(Ability)); break;
+        default:                      break;
+        }
+    }
+}
+
+UAbilityBenchmarkCommandlet::UAbilityBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = true;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UAbilityBenchmarkCommandlet::Main(const FString& Params)
+{
+    FString Suite = TEXT("All");
+    FParse::Value(*Params, TEXT("Suite="), Suite);
+    Results.Reset();
+    NumFailures = 0;
+
+    const bool bAll = Suite.Equals(TEXT("All"), ESearchCase::IgnoreCase);
+    if (bAll || Suite.Equals(TEXT("Replication"), ESearchCase::IgnoreCase))
+    {
+        RunReplicationSuite(Params);
+    }
+    if (bAll || Suite.Equals(TEXT("Journal"), ESearchCase::IgnoreCase))
+    {
+        RunJournalSuite(Params);
+    }
+    if (bAll || Suite.Equals(TEXT("Codec"), ESearchCase::IgnoreCase))
+    {
+        RunCodecSuite(Params);
+    }
+    if (bAll || Suite.Equals(TEXT("Effects"), ESearchCase::IgnoreCase))
+    {
+        RunEffectSuite(Params);
+    }
+    if (bAll || Suite.Equals(TEXT("Micro"), ESearchCase::IgnoreCase))
+    {
+        RunMicroSuite(Params);
+    }
+
+    if (Results.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("AbilityBenchmark: unknown suite '%s'."), *Suite);
+        return 1;
+    }
+
+    TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetArrayField(TEXT("results"), Results);
+
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Report, Writer);
+    UE_LOG(LogTemp, Display, TEXT("%s"), *Json);
+
+    FString OutputPath;
+    if (FParse::Value(*Params, TEXT("Output="), OutputPath) && !FFileHelper::SaveStringToFile(Json, *OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("AbilityBenchmark: failed to write '%s'."), *OutputPath);
+        return 1;
+    }
+
+    if (NumFailures > 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("AbilityBenchmark: %d round-trip checks failed."), NumFailures);
+        return 1;
+    }
+    return 0;
+}
+
+// ------------------ Suites ------------------
+
+void UAbilityBenchmarkCommandlet::RunReplicationSuite(const FString& Params)
+{
+    using namespace AbilityBenchmark;
+
+    int32 NumConnections = 16;
+    int32 NumCharacters = 1000;
+    int32 NumUpdates = 300;
+    float NetRate = 30.f;
+    int32 Seed = 1;
+    float UnlockRate = 0.05f;
+    float UpgradeRate = 0.05f;
+    float AllocationRate = 0.02f;
+    float CooldownRate = 0.1f;
+    FParse::Value(*Params, TEXT("Connections="), NumConnections);
+    FParse::Value(*Params, TEXT("Characters="), NumCharacters);
+    FParse::Value(*Params, TEXT("Updates="), NumUpdates);
+    FParse::Value(*Params, TEXT("NetRate="), NetRate);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("UnlockRate="), UnlockRate);
+    FParse::Value(*Params, TEXT("UpgradeRate="), UpgradeRate);
+    FParse::Value(*Params, TEXT("AllocationRate="), AllocationRate);
+    FParse::Value(*Params, TEXT("CooldownRate="), CooldownRate);
+
+    // Replicated properties with their lifetime condition, as the rep layout would see them.
+    // Push-based properties are only compared after the traces below called a mutator that marks
+    // them dirty; inherited push-based ones are never written by these traces.
+    constexpr uint32 AbilityStateTraffic = 1u << 0;
+    constexpr uint32 ProgressionTraffic = 1u << 1;
+    struct FRepProperty
+    {
+        FProperty* Property = nullptr;
+        uint32 Handle = 0;
+        ELifetimeCondition Condition = COND_None;
+        uint32 DirtyBit = 0;
+        bool bPushBased = false;
+    };
+    UClass* ComponentClass = UAbilityComponent::StaticClass();
+    ComponentClass->SetUpRuntimeReplicationData();
+    TArray<FLifetimeProperty> LifetimeProps;
+    GetDefault<UAbilityComponent>()->GetLifetimeReplicatedProps(LifetimeProps);
+
+    TArray<FRepProperty> RepProperties;
+    for (const FLifetimeProperty& Lifetime : LifetimeProps)
+    {
+        if (Lifetime.Condition == COND_Never)
+        {
+            continue;
+        }
+        FRepProperty& Rep = RepProperties.AddDefaulted_GetRef();
+        Rep.Property = ComponentClass->ClassReps[Lifetime.RepIndex].Property;
+        Rep.Handle = static_cast<uint32>(Lifetime.RepIndex) + 1;
+        Rep.Condition = Lifetime.Condition;
+        Rep.bPushBased = Lifetime.bIsPushBased;
+        const FName Name = Rep.Property->GetFName();
+        Rep.DirtyBit = Name == TEXT("AbilityState") ? AbilityStateTraffic : Name == TEXT("Progression") ? ProgressionTraffic : 0u;
+    }
+
+    // Each character is owned by one connection and has a shadow holding the last replicated state,
+    // shared by all connections. Owning actors give the components authority and a world clock.
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    TArray<UAbilityComponent*> Characters;
+    TArray<UAbilityComponent*> Shadows;
+    TArray<uint32> DirtyMasks;
+    DirtyMasks.SetNumZeroed(NumCharacters);
+    for (int32 Index = 0; Index < NumCharacters; ++Index)
+    {
+        UAbilityComponent* Character = CreateBenchmarkComponent(World->SpawnActor<AActor>());
+        UAbilityComponent* Shadow = NewObject<UAbilityBenchmarkComponent>(GetTransientPackage(), NAME_None, RF_NoFlags, Character);
+        Shadow->AddToRoot();
+        Characters.Add(Character);
+        Shadows.Add(Shadow);
+    }
+
+    FRandomStream Random(Seed);
+    const float UnlockChance = UnlockRate / NetRate;
+    const float UpgradeChance = UpgradeRate / NetRate;
+    const float AllocationChance = AllocationRate / NetRate;
+    const float CooldownChance = CooldownRate / NetRate;
+
+    uint64 CompareCycles = 0;
+    uint64 SerializeCycles = 0;
+    int64 TotalBits = 0;
+    int64 ChangedUpdates = 0;
+    TArray<const FRepProperty*, TInlineAllocator<8>> Changed;
+    TArray<FAbilityAllocationDelta> Batch;
+
+    for (int32 Update = 0; Update < NumUpdates; ++Update)
+    {
+        World->TimeSeconds = (Update + 1) / NetRate;
+
+        // Scripted gameplay traffic between net updates, through the component's server paths.
+        for (int32 Index = 0; Index < NumCharacters; ++Index)
+        {
+            UAbilityComponent* Character = Characters[Index];
+            uint32& DirtyMask = DirtyMasks[Index];
+            if (Random.FRand() < UnlockChance)
+            {
+                DirtyMask |= AbilityStateTraffic;
+                switch (Random.RandRange(0, 3))
+                {
+                case 0: Character->UnlockCombatAbility(RandomAbility<ECombatAbility>(Random)); break;
+                case 1: Character->UnlockSupportAbility(RandomAbility<ESupportAbility>(Random)); break;
+                case 2: Character->UnlockMovementAbility(RandomAbility<EMovementAbility>(Random)); break;
+                default: Character->UnlockControlAbility(RandomAbility<EControlAbility>(Random)); break;
+                }
+            }
+            if (Random.FRand() < UpgradeChance)
+            {
+                DirtyMask |= AbilityStateTraffic;
+                switch (Random.RandRange(0, 3))
+                {
+                case 0: Character->UpgradeCombatAbility(RandomAbility<ECombatAbility>(Random)); break;
+                case 1: Character->UpgradeSupportAbility(RandomAbility<ESupportAbility>(Random)); break;
+                case 2: Character->UpgradeMovementAbility(RandomAbility<EMovementAbility>(Random)); break;
+                default: Character->UpgradeControlAbility(RandomAbility<EControlAbility>(Random)); break;
+                }
+            }
+            if (Random.FRand() < AllocationChance)
+            {
+                Batch.Reset();
+                for (int32 Entry = Random.RandRange(1, 3); Entry > 0; --Entry)
+                {
+                    Batch.Add(RandomAllocation(Random));
+                }
+                Character->AllocateAbilityPoints(Batch);
+                DirtyMask |= ProgressionTraffic;
+            }
+            if (Random.FRand() < CooldownChance)
+            {
+                // Only unlocked abilities can be activated.
+                const int32 Slot = RandomUnlockedSlot(Character->GetUnlockedMask(), Random);
+                if (Slot != INDEX_NONE)
+                {
+                    DirtyMask |= AbilityStateTraffic;
+                    Character->StartAbilityCooldown(static_cast<EAbilityGroup>(Slot / AbilitySlot::GroupStride), static_cast<uint8>(Slot % AbilitySlot::GroupStride));
+                }
+            }
+        }
+
+        // Net update: compare once per character, serialize changes for every connection the
+        // property's condition replicates to.
+        for (int32 Index = 0; Index < NumCharacters; ++Index)
+        {
+            UAbilityComponent* Character = Characters[Index];
+            UAbilityComponent* Shadow = Shadows[Index];
+
+            Changed.Reset();
+            const uint64 CompareStart = FPlatformTime::Cycles64();
+            const uint32 DirtyMask = DirtyMasks[Index];
+            DirtyMasks[Index] = 0;
+            for (const FRepProperty& Rep : RepProperties)
+            {
+                const bool bCompare = !Rep.bPushBased || (DirtyMask & Rep.DirtyBit) != 0;
+                if (bCompare && !Rep.Property->Identical_InContainer(Character, Shadow))
+                {
+                    Changed.Add(&Rep);
+                }
+            }
+            CompareCycles += FPlatformTime::Cycles64() - CompareStart;
+
+            if (Changed.IsEmpty())
+            {
+                continue;
+            }
+            ++ChangedUpdates;
+
+            const int32 OwnerConnection = Index % NumConnections;
+            const uint64 SerializeStart = FPlatformTime::Cycles64();
+            for (int32 Connection = 0; Connection < NumConnections; ++Connection)
+            {
+                const bool bOwner = Connection == OwnerConnection;
+                FNetBitWriter Writer(nullptr, 8192);
+                for (const FRepProperty* Rep : Changed)
+                {
+                    if (!ReplicatesTo(Rep->Condition, bOwner))
+                    {
+                        continue;
+                    }
+                    uint32 Handle = Rep->Handle;
+                    Writer.SerializeIntPacked(Handle);
+                    Rep->Property->NetSerializeItem(Writer, nullptr, Rep->Property->ContainerPtrToValuePtr<void>(Character));
+                }
+                TotalBits += Writer.GetNumBits();
+            }
+            SerializeCycles += FPlatformTime::Cycles64() - SerializeStart;
+
+            for (const FRepProperty* Rep : Changed)
+            {
+                Rep->Property->CopyCompleteValue_InContainer(Shadow, Character);
+            }
+        }
+    }
+
+    for (UAbilityComponent* Shadow : Shadows)
+    {
+        Shadow->RemoveFromRoot();
+    }
+    World->DestroyWorld(false);
+
+    const double SimulatedSeconds = NumUpdates / NetRate;
+    const TCHAR* SuiteName = TEXT("Replication");
+    AddResult(SuiteName, TEXT("BytesPerSecondPerConnection"), TotalBits / 8.0 / NumConnections / SimulatedSeconds, TEXT("B/s"));
+    AddResult(SuiteName, TEXT("SerializeTime"), CyclesToMs(SerializeCycles), TEXT("ms"));
+    AddResult(SuiteName, TEXT("SerializeTimePerUpdate"), CyclesToMs(SerializeCycles) / NumUpdates, TEXT("ms"));
+    AddResult(SuiteName, TEXT("CompareTime"), CyclesToMs(CompareCycles), TEXT("ms"));
+    AddResult(SuiteName, TEXT("CompareTimePerUpdate"), CyclesToMs(CompareCycles) / NumUpdates, TEXT("ms"));
+    AddResult(SuiteName, TEXT("ChangedCharactersPerUpdate"), static_cast<double>(ChangedUpdates) / NumUpdates, TEXT("count"));
+}
+
+void UAbilityBenchmarkCommandlet::RunJournalSuite(const FString& Params)
+{
+    using namespace AbilityBenchmark;
+
+    int32 NumMutations = 100000;
+    int32 Threshold = FAbilityJournal::DefaultCompactionThreshold;
+    int32 Seed = 1;
+    FParse::Value(*Params, TEXT("Mutations="), NumMutations);
+    FParse::Value(*Params, TEXT("Threshold="), Threshold);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+
+    FAbility Ability;
+    Ability.SetMaxAbilityPoints(40);
+    FRandomStream Random(Seed);
+
+    // Pre-generate the mutation trace so both persistence paths see identical work.
+    TArray<FAbilityAllocationDelta> Trace;
+    Trace.Reserve(NumMutations);
+    for (int32 Index = 0; Index < NumMutations; ++Index)
+    {
+        Trace.Add(RandomAllocation(Random));
+    }
+
+    // Full save on every change.
+    FAbility FullSaveAbility = Ability;
+    TArray<uint8> FullSave;
+    const uint64 FullSaveStart = FPlatformTime::Cycles64();
+    for (const FAbilityAllocationDelta& Delta : Trace)
+    {
+        if (FullSaveAbility.ApplyAllocationBatch(MakeArrayView(&Delta, 1)))
+        {
+            FullSave.Reset();
+            AbilitySaveFormat::SaveToBytes(FullSaveAbility, FullSave);
+        }
+    }
+    const uint64 FullSaveCycles = FPlatformTime::Cycles64() - FullSaveStart;
+
+    // Journal append on every change, compacting at the threshold.
+    FAbility JournalAbility = Ability;
+    FAbilityJournal Journal(Threshold);
+    int32 Applied = 0;
+    const uint64 JournalStart = FPlatformTime::Cycles64();
+    for (const FAbilityAllocationDelta& Delta : Trace)
+    {
+        if (JournalAbility.ApplyAllocationBatch(MakeArrayView(&Delta, 1)))
+        {
+            Journal.AppendModule(Delta.Category, Delta.Type, *JournalAbility.FindModule(Delta.Category, Delta.Type));
+            Journal.AppendPool(JournalAbility);
+            if (Journal.NeedsCompaction())
+            {
+                Journal.Compact(JournalAbility);
+            }
+            ++Applied;
+        }
+    }
+    const uint64 JournalCycles = FPlatformTime::Cycles64() - JournalStart;
+
+    // Recovery: snapshot load alone versus snapshot plus a full-length log.
+    const int32 RecoveryRuns = 1000;
+    FAbility Recovered;
+    const uint64 SnapshotLoadStart = FPlatformTime::Cycles64();
+    for (int32 Run = 0; Run < RecoveryRuns; ++Run)
+    {
+        AbilitySaveFormat::LoadFromBytes(FullSave, Recovered);
+    }
+    const uint64 SnapshotLoadCycles = FPlatformTime::Cycles64() - SnapshotLoadStart;
+
+    while (!Journal.NeedsCompaction() && Journal.GetNumEntries() > 0)
+    {
+        Journal.AppendPool(JournalAbility);
+    }
+    const uint64 ReplayStart = FPlatformTime::Cycles64();
+    for (int32 Run = 0; Run < RecoveryRuns; ++Run)
+    {
+        Journal.Recover(Recovered);
+    }
+    const uint64 ReplayCycles = FPlatformTime::Cycles64() - ReplayStart;
+
+    if (Recovered != JournalAbility || JournalAbility != FullSaveAbility)
+    {
+        UE_LOG(LogTemp, Error, TEXT("AbilityBenchmark: journal recovery diverged from the live state."));
+        ++NumFailures;
+    }
+
+    const TCHAR* SuiteName = TEXT("Journal");
+    const double Changes = FMath::Max(Applied, 1);
+    AddResult(SuiteName, TEXT("FullSavePerChange"), CyclesToMs(FullSaveCycles) * 1000000.0 / Changes, TEXT("ns"));
+    AddResult(SuiteName, TEXT("JournalAppendPerChange"), CyclesToMs(JournalCycles) * 1000000.0 / Changes, TEXT("ns"));
+    AddResult(SuiteName, TEXT("FullSaveBytes"), FullSave.Num(), TEXT("B"));
+    AddResult(SuiteName, TEXT("SnapshotLoad"), CyclesToMs(SnapshotLoadCycles) * 1000.0 / RecoveryRuns, TEXT("us"));
+    AddResult(SuiteName, TEXT("SnapshotPlusReplay"), CyclesToMs(ReplayCycles) * 1000.0 / RecoveryRuns, TEXT("us"));
+    AddResult(SuiteName, TEXT("ReplayedEntries"), Journal.GetNumEntries(), TEXT("count"));
+}
+
+void UAbilityBenchmarkCommandlet::RunCodecSuite(const FString& Params)
+{
+    using namespace AbilityBenchmark;
+
+    int32 NumPlayers = 10000;
+    float Density = 0.15f;
+    float Churn = 0.05f;
+    int32 Seed = 1;
+    FParse::Value(*Params, TEXT("Players="), NumPlayers);
+    FParse::Value(*Params, TEXT("Density="), Density);
+    FParse::Value(*Params, TEXT("Churn="), Churn);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+
+    // Yesterday's and today's snapshot per player; today differs by a small churn.
+    FRandomStream Random(Seed);
+    TArray<FAbility> Previous;
+    TArray<FAbility> Current;
+    Previous.SetNum(NumPlayers);
+    Current.SetNum(NumPlayers);
+    int64 RawBytes = 0;
+    TArray<uint8> Scratch;
+    for (int32 Index = 0; Index < NumPlayers; ++Index)
+    {
+        RandomizeProgression(Previous[Index], Random, Density);
+        Current[Index] = Previous[Index];
+        RandomizeProgression(Current[Index], Random, Churn);
+
+        Scratch.Reset();
+        AbilitySaveFormat::SaveToBytes(Current[Index], Scratch);
+        RawBytes += Scratch.Num();
+    }
+
+    TArray<TArray<uint8>> Encoded;
+    Encoded.SetNum(NumPlayers);
+    FAbility Decoded;
+    const TCHAR* SuiteName = TEXT("Codec");
+
+    for (int32 Mode = 0; Mode < 2; ++Mode)
+    {
+        const bool bDelta = Mode == 1;
+        const TCHAR* Label = bDelta ? TEXT("Delta") : TEXT("Full");
+
+        int64 EncodedBytes = 0;
+        const uint64 EncodeStart = FPlatformTime::Cycles64();
+        for (int32 Index = 0; Index < NumPlayers; ++Index)
+        {
+            AbilitySnapshotCodec::Encode(Current[Index], bDelta ? &Previous[Index] : nullptr, Encoded[Index]);
+            EncodedBytes += Encoded[Index].Num();
+        }
+        const double EncodeSeconds = CyclesToMs(FPlatformTime::Cycles64() - EncodeStart) / 1000.0;
+
+        int32 Mismatches = 0;
+        const uint64 DecodeStart = FPlatformTime::Cycles64();
+        for (int32 Index = 0; Index < NumPlayers; ++Index)
+        {
+            AbilitySnapshotCodec::Decode(Encoded[Index], bDelta ? &Previous[Index] : nullptr, Decoded);
+            Mismatches += Decoded != Current[Index] ? 1 : 0;
+        }
+        const double DecodeSeconds = CyclesToMs(FPlatformTime::Cycles64() - DecodeStart) / 1000.0;
+
+        if (Mismatches > 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("AbilityBenchmark: %d %s snapshots did not round-trip."), Mismatches, Label);
+            ++NumFailures;
+        }
+
+        // Throughput is measured against the equivalent compact save size.
+        const double RawMB = RawBytes / (1024.0 * 1024.0);
+        AddResult(SuiteName, FString::Printf(TEXT("%sEncodeThroughput"), Label), RawMB / FMath::Max(EncodeSeconds, 1e-9), TEXT("MB/s"));
+        AddResult(SuiteName, FString::Printf(TEXT("%sDecodeThroughput"), Label), RawMB / FMath::Max(DecodeSeconds, 1e-9), TEXT("MB/s"));
+        AddResult(SuiteName, FString::Printf(TEXT("%sBytesPerPlayer"), Label), static_cast<double>(EncodedBytes) / NumPlayers, TEXT("B"));
+        AddResult(SuiteName, FString::Printf(TEXT("%sCompressionRatio"), Label), static_cast<double>(RawBytes) / FMath::Max<int64>(EncodedBytes, 1), TEXT("x"));
+    }
+}
+
+void UAbilityBenchmarkCommandlet::RunEffectSuite(const FString& Params)
+{
+    using namespace AbilityBenchmark;
+
+    int32 NumTargets = 1000;
+    float ImmuneShare = 0.1f;
+    int32 Iterations = 200;
+    int32 Seed = 1;
+    FParse::Value(*Params, TEXT("Targets="), NumTargets);
+    FParse::Value(*Params, TEXT("Immune="), ImmuneShare);
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    UAbilityEffectSubsystem* Effects = World->GetSubsystem<UAbilityEffectSubsystem>();
+
+    FRandomStream Random(Seed);
+    TArray<AActor*> Targets;
+    Targets.Reserve(NumTargets);
+    for (int32 Index = 0; Index < NumTargets; ++Index)
+    {
+        Targets.Add(World->SpawnActor<AActor>());
+    }
+    auto SeedImmunities = [&]()
+    {
+        for (AActor* Target : Targets)
+        {
+            if (Random.FRand() < ImmuneShare)
+            {
+                Effects->SetEffectImmunity(Target, EControlAbility::Stun, true);
+            }
+        }
+    };
+
+    const TCHAR* SuiteName = TEXT("Effects");
+
+    for (int32 Mode = 0; Mode < 2; ++Mode)
+    {
+        const bool bBatch = Mode == 1;
+        const TCHAR* Label = bBatch ? TEXT("Batch") : TEXT("PerTarget");
+
+        uint64 Cycles = 0;
+        int32 Affected = 0;
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            Effects->ClearEffects();
+            SeedImmunities();
+
+            const uint64 Start = FPlatformTime::Cycles64();
+            if (bBatch)
+            {
+                Affected += Effects->ApplyEffectBatch(Targets, EControlAbility::Stun, 1.f, 2.f);
+            }
+            else
+            {
+                for (AActor* Target : Targets)
+                {
+                    Affected += Effects->ApplyEffect(Target, EControlAbility::Stun, 1.f, 2.f) ? 1 : 0;
+                }
+            }
+            Cycles += FPlatformTime::Cycles64() - Start;
+        }
+
+        AddResult(SuiteName, FString::Printf(TEXT("%sApplyTime"), Label), CyclesToMs(Cycles) / FMath::Max(Iterations, 1), TEXT("ms"));
+        AddResult(SuiteName, FString::Printf(TEXT("%sAffected"), Label), static_cast<double>(Affected) / FMath::Max(Iterations, 1), TEXT("targets"));
+    }
+
+    // Burn on every target, ticking ten times a second for the whole duration.
+    Effects->ClearEffects();
+    Effects->ApplyEffectBatch(Targets, EControlAbility::Burn, 1.f, 1000.f, 0.1f);
+    const uint64 TickStart = FPlatformTime::Cycles64();
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        Effects->ProcessEffects(0.1f * (Iteration + 1));
+    }
+    AddResult(SuiteName, TEXT("BurnTickTime"), CyclesToMs(FPlatformTime::Cycles64() - TickStart) / FMath::Max(Iterations, 1), TEXT("ms"));
+
+    World->DestroyWorld(false);
+}
+
+void UAbilityBenchmarkCommandlet::RunMicroSuite(const FString& Params)
+{
+    using namespace AbilityBenchmark;
+
+    FString PopulationList = TEXT("100,1000,10000");
+    int32 NumOps = 100000;
+    int32 Seed = 1;
+    FParse::Value(*Params, TEXT("Populations="), PopulationList, false);
+    FParse::Value(*Params, TEXT("Ops="), NumOps);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    NumOps = FMath::Max(NumOps, 1);
+
+    TArray<FString> PopulationTexts;
+    PopulationList.ParseIntoArray(PopulationTexts, TEXT(","));
+
+    const TCHAR* SuiteName = TEXT("Micro");
+
+    // Every measured result feeds the sink so the optimizer cannot drop the work.
+    int64 Sink = 0;
+
+    for (const FString& PopulationText : PopulationTexts)
+    {
+        const int32 Population = FMath::Max(FCString::Atoi(*PopulationText), 1);
+        FRandomStream Random(Seed);
+
+        // Construction, once per population.
+        TArray<UAbilityBenchmarkComponent*> Components;
+        Components.Reserve(Population);
+        uint64 Start = FPlatformTime::Cycles64();
+        for (int32 Index = 0; Index < Population; ++Index)
+        {
+            Components.Add(CreateBenchmarkComponent());
+        }
+        AddResult(SuiteName, FString::Printf(TEXT("ComponentConstruct.N%d"), Population), CyclesToMs(FPlatformTime::Cycles64() - Start) * 1000000.0 / Population, TEXT("ns"));
+
+        TArray<FAbility> Progressions;
+        Start = FPlatformTime::Cycles64();
+        Progressions.SetNum(Population);
+        AddResult(SuiteName, FString::Printf(TEXT("ProgressionConstruct.N%d"), Population), CyclesToMs(FPlatformTime::Cycles64() - Start) * 1000000.0 / Population, TEXT("ns"));
+
+        // Progress every module so increase and decrease have room in both directions.
+        TArray<FAbility> Copies;
+        TArray<TArray<uint8>> NetBytes;
+        TArray<int64> NetBits;
+        NetBytes.SetNum(Population);
+        NetBits.SetNum(Population);
+        for (int32 Index = 0; Index < Population; ++Index)
+        {
+            RandomizeProgression(Progressions[Index], Random, 1.f);
+
+            FBitWriter Writer(0, true);
+            bool bSuccess = false;
+            Progressions[Index].NetSerialize(Writer, nullptr, bSuccess);
+            NetBytes[Index] = *Writer.GetBuffer();
+            NetBits[Index] = Writer.GetNumBits();
+        }
+        Copies = Progressions;
+
+        TArray<FAccess> Accesses;
+        FAbility Scratch;
+        FBitWriter Writer(0, true);
+
+        for (int32 PatternIndex = 0; PatternIndex < static_cast<int32>(EAccessPattern::Max); ++PatternIndex)
+        {
+            GenerateAccesses(static_cast<EAccessPattern>(PatternIndex), Population, NumOps, Random, Accesses);
+
+            // Every pattern starts from the same state, so unlocks and upgrades are not no-ops left over
+            // from the previous pattern and the results are comparable across patterns.
+            for (UAbilityBenchmarkComponent* Component : Components)
+            {
+                Component->ResetAbilities();
+            }
+            Progressions = Copies;
+
+            auto Measure = [&](const TCHAR* Op, auto&& Body)
+            {
+                const uint64 OpStart = FPlatformTime::Cycles64();
+                for (const FAccess& Access : Accesses)
+                {
+                    Body(Access);
+                }
+                const double Nanoseconds = CyclesToMs(FPlatformTime::Cycles64() - OpStart) * 1000000.0 / NumOps;
+                AddResult(SuiteName, FString::Printf(TEXT("%s.%s.N%d"), Op, AccessPatternNames[PatternIndex], Population), Nanoseconds, TEXT("ns"));
+            };
+
+            Measure(TEXT("ComponentLookup"), [&](const FAccess& Access)
+            {
+                Sink += IsUnlocked(*Components[Access.Entity], Access.Group, Access.Ability) ? 1 : 0;
+            });
+            Measure(TEXT("ComponentUnlock"), [&](const FAccess& Access)
+            {
+                Unlock(*Components[Access.Entity], Access.Group, Access.Ability);
+            });
+            Measure(TEXT("ComponentUpgrade"), [&](const FAccess& Access)
+            {
+                Upgrade(*Components[Access.Entity], Access.Group, Access.Ability);
+            });
+            Measure(TEXT("ProgressionLookup"), [&](const FAccess& Access)
+            {
+                FAbilityModule Module;
+                Progressions[Access.Entity].GetModule(Access.Category, Access.Type, Module);
+                Sink += Module.Point;
+            });
+            Measure(TEXT("IncreaseDecrease"), [&](const FAccess& Access)
+            {
+                FAbility& Ability = Progressions[Access.Entity];
+                Sink += Ability.IncreaseAbilityByCategory(Access.Category, Access.Type) ? 1 : 0;
+                Sink += Ability.DecreaseAbilityByCategory(Access.Category, Access.Type) ? 1 : 0;
+            });
+            Measure(TEXT("Equality"), [&](const FAccess& Access)
+            {
+                Sink += Progressions[Access.Entity] == Copies[Access.Entity] ? 1 : 0;
+            });
+            Measure(TEXT("Copy"), [&](const FAccess& Access)
+            {
+                Scratch = Progressions[Access.Entity];
+                Sink += Scratch.GetAllocatedPoints();
+            });
+            Measure(TEXT("NetSerialize"), [&](const FAccess& Access)
+            {
+                Writer.Reset();
+                bool bSuccess = false;
+                Progressions[Access.Entity].NetSerialize(Writer, nullptr, bSuccess);
+                Sink += Writer.GetNumBits();
+            });
+            Measure(TEXT("NetDeserialize"), [&](const FAccess& Access)
+            {
+                FBitReader Reader(NetBytes[Access.Entity].GetData(), NetBits[Access.Entity]);
+                bool bSuccess = false;
+                Scratch.NetSerialize(Reader, nullptr, bSuccess);
+                Sink += Scratch.GetAbilityPoints();
+            });
+        }
+
+        // Let the next population start from a clean heap.
+        Components.Reset();
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("AbilityBenchmark: micro suite sink %lld."), Sink);
+}
+
+// ------------------ Helpers ------------------
+
+UAbilityBenchmarkComponent* UAbilityBenchmarkCommandlet::CreateBenchmarkComponent(AActor* Owner) const
+{
+    UAbilityBenchmarkComponent* Component = Owner ? NewObject<UAbilityBenchmarkComponent>(Owner) : NewObject<UAbilityBenchmarkComponent>(GetTransientPackage());
+    Component->ResetAbilities();
+    return Component;
+}
+
+void UAbilityBenchmarkCommandlet::AddResult(const FString& Suite, const FString& Name, double Value, const FString& Unit)
+{
+    TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("suite"), Suite);
+    Result->SetStringField(TEXT("name"), Name);
+    Result->SetNumberField(TEXT("value"), Value);
+    Result->SetStringField(TEXT("unit"), Unit);
+    Results.Add(MakeShared<FJsonValueObject>(Result));
+
+    UE_LOG(LogTemp, Display, TEXT("%s.%s = %.3f %s"), *Suite, *Name, Value, *Unit);
+}
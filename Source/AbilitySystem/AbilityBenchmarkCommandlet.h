@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AbilityBenchmarkCommandlet.generated.h"
+
+class AActor;
+class UAbilityBenchmarkComponent;
+
+/**
+ * Headless benchmark runner for the ability system.
+ *
+ * Usage: -run=AbilityBenchmark -nullrhi -Suite=<All|Replication|Journal|Codec|Effects|Micro> [-Output=Results.json]
+ *
+ * Every suite appends its measurements to a JSON report that is logged and optionally written to -Output.
+ * Suites that verify behaviour (codec and journal round-trips) count failures; any failure makes the
+ * commandlet return non-zero after the report is written.
+ */
+UCLASS()
+class UAbilityBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAbilityBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+
+    // ------------------ Suites ------------------
+
+    /**
+     * Replication cost of ability state.
+     * Simulates M characters replicating to N loopback connections at a fixed net rate while scripted
+     * unlock, upgrade, allocation and cooldown traces drive them through the component API. Like the
+     * push model, a push-based property is only compared against the per-character shadow after it was
+     * marked dirty; changed properties are serialized for every connection their lifetime condition
+     * replicates to, with each character owned by one connection.
+     *
+     * Params: -Connections=16 -Characters=1000 -Updates=300 -NetRate=30 -Seed=1
+     */
+    void RunReplicationSuite(const FString& Params);
+
+    /**
+     * Incremental progression persistence.
+     * Compares persisting every mutation as a full compact save against a journal append, and
+     * recovery from a snapshot plus journal replay against loading a full save.
+     *
+     * Params: -Mutations=100000 -Threshold=256 -Seed=1
+     */
+    void RunJournalSuite(const FString& Params);
+
+    /**
+     * Archived snapshot compression.
+     * Encodes and decodes a synthetic population of sparse snapshots, in full and as deltas against
+     * the previous day, and reports throughput and compression ratio against the compact save format.
+     *
+     * Params: -Players=10000 -Density=0.15 -Churn=0.05 -Seed=1
+     */
+    void RunCodecSuite(const FString& Params);
+
+    /**
+     * Area application of control effects.
+     * Applies one Stun to a target list, once target by target and once as a single batch, with a
+     * share of the targets immune, then ticks burns on the same population.
+     *
+     * Params: -Targets=1000 -Immune=0.1 -Iterations=200 -Seed=1
+     */
+    void RunEffectSuite(const FString& Params);
+
+    /**
+     * Per-operation cost of the ability core.
+     * Times component lookup, unlock and upgrade, and FAbility lookup, increase/decrease, equality,
+     * copy, construction and net serialization over populations of several sizes, each under a hot
+     * key, uniform random and sequential access pattern. Results are ns per operation, named
+     * <Op>.<Pattern>.N<Population>; construction is pattern independent and named <Op>.N<Population>.
+     *
+     * Params: -Populations=100,1000,10000 -Ops=100000 -Seed=1
+     */
+    void RunMicroSuite(const FString& Params);
+
+    // ------------------ Helpers ------------------
+
+    /** Create a component with every ability slot present and a progression pool to spend, owned by Owner if given */
+    UAbilityBenchmarkComponent* CreateBenchmarkComponent(AActor* Owner = nullptr) const;
+
+    /** Record one named measurement in the report */
+    void AddResult(const FString& Suite, const FString& Name, double Value, const FString& Unit);
+
+    /** Collected measurements */
+    TArray<TSharedPtr<class FJsonValue>> Results;
+
+    /** Round-trip checks that failed in this run */
+    int32 NumFailures = 0;
+};
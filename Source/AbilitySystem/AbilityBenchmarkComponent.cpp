@@ -0,0 +1,30 @@
+#include "AbilityBenchmarkComponent.h"
+#include "AbilityBenchmarkUtils.h"
+
+UAbilityBenchmarkComponent::UAbilityBenchmarkComponent()
+{
+    SeedDefaults();
+}
+
+void UAbilityBenchmarkComponent::ResetAbilities()
+{
+    CombatAbilities.Reset();
+    SupportAbilities.Reset();
+    MovementAbilities.Reset();
+    ControlAbilities.Reset();
+    SeedDefaults();
+
+    FAbility Fresh;
+    Fresh.SetMaxAbilityPoints(40);
+    SetProgression(Fresh);
+    RebuildAbilityState();
+}
+
+void UAbilityBenchmarkComponent::SeedDefaults()
+{
+    AbilityBenchmark::SeedAbilities(CombatAbilities);
+    AbilityBenchmark::SeedAbilities(SupportAbilities);
+    AbilityBenchmark::SeedAbilities(MovementAbilities);
+    AbilityBenchmark::SeedAbilities(ControlAbilities);
+    Progression.SetMaxAbilityPoints(40);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilityComponent.h"
+#include "AbilityBenchmarkComponent.generated.h"
+
+/**
+ * Ability component populated the way a designer-authored subclass would be: every ability slot
+ * present and a progression pool to spend. Used by the benchmark and stress commandlets, which
+ * otherwise drive it only through the public UAbilityComponent API.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class UAbilityBenchmarkComponent : public UAbilityComponent
+{
+    GENERATED_BODY()
+
+public:
+    UAbilityBenchmarkComponent();
+
+    /** Back to the freshly constructed state: every slot locked at level zero and an unspent pool */
+    void ResetAbilities();
+
+private:
+
+    /** Fill every ability map and give the progression its pool */
+    void SeedDefaults();
+};
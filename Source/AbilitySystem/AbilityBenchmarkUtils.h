@@ -0,0 +1,84 @@
+#pragma once
+
+#include "AbilityBuildOptimizer.h"
+#include "AbilityType.h"
+#include "Math/RandomStream.h"
+
+/**
+ * Population and traffic helpers shared by the benchmark and stress commandlets. Per-category
+ * progression type counts come from AbilityBuild::NumTypes.
+ */
+namespace AbilityBenchmark
+{
+    /** Fill an ability map with a default entry for every enum value except None */
+    template<typename EnumType>
+    void SeedAbilities(TMap<EnumType, FAbilityData>& Abilities)
+    {
+        for (uint8 Index = 1; Index < static_cast<uint8>(EnumType::Max); ++Index)
+        {
+            Abilities.Add(static_cast<EnumType>(Index), FAbilityData());
+        }
+    }
+
+    /** Number of abilities of a group, excluding None */
+    inline int32 NumAbilities(EAbilityGroup Group)
+    {
+        switch (Group)
+        {
+        case EAbilityGroup::Combat:   return static_cast<int32>(ECombatAbility::Max) - 1;
+        case EAbilityGroup::Support:  return static_cast<int32>(ESupportAbility::Max) - 1;
+        case EAbilityGroup::Movement: return static_cast<int32>(EMovementAbility::Max) - 1;
+        case EAbilityGroup::Control:  return static_cast<int32>(EControlAbility::Max) - 1;
+        default:                      return 0;
+        }
+    }
+
+    /** A random slot set in an unlock mask, or INDEX_NONE if nothing is unlocked */
+    inline int32 RandomUnlockedSlot(uint32 UnlockedMask, FRandomStream& Random)
+    {
+        if (UnlockedMask == 0)
+        {
+            return INDEX_NONE;
+        }
+
+        int32 Slot = Random.RandRange(0, AbilitySlot::Num - 1);
+        while ((UnlockedMask & (1u << Slot)) == 0)
+        {
+            Slot = (Slot + 1) % AbilitySlot::Num;
+        }
+        return Slot;
+    }
+
+    /**
+     * Pick a single-module allocation that the progression accepts: an allocation (75%) only below
+     * the module's MaxPoint with room in the pool, a refund only from a module with points allocated.
+     * Returns false if the picked module can move in neither direction.
+     */
+    inline bool RandomValidAllocation(const FAbility& Ability, FRandomStream& Random, FAbilityAllocationDelta& OutDelta)
+    {
+        OutDelta.Category = static_cast<EAbilityCategory>(Random.RandRange(1, static_cast<int32>(EAbilityCategory::Max) - 1));
+        OutDelta.Type = static_cast<uint8>(Random.RandRange(1, AbilityBuild::NumTypes(OutDelta.Category)));
+
+        const FAbilityModule* Module = Ability.FindModule(OutDelta.Category, OutDelta.Type);
+        if (!Module)
+        {
+            return false;
+        }
+
+        const bool bCanAllocate = Module->AllocatedPoint < Module->MaxPoint && Ability.GetAllocatedPoints() < Ability.GetMaxAbilityPoints();
+        const bool bCanRefund = Module->AllocatedPoint > 0;
+        if (bCanAllocate && (!bCanRefund || Random.FRand() < 0.75f))
+        {
+            OutDelta.Delta = 1;
+        }
+        else if (bCanRefund)
+        {
+            OutDelta.Delta = -1;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,193 @@
+#include "AbilityBuildOptimizerCommandlet.h"
+#include "AbilityBuildOptimizer.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    /** Type enum of a progression category */
+    const UEnum* GetTypeEnum(EAbilityCategory Category)
+    {
+        switch (Category)
+        {
+        case EAbilityCategory::Martial:  return StaticEnum<EMartialAbilityType>();
+        case EAbilityCategory::Magical:  return StaticEnum<EMagicalAbilityType>();
+        case EAbilityCategory::Crafting: return StaticEnum<ECraftingAbilityType>();
+        case EAbilityCategory::Survival: return StaticEnum<ESurvivalAbilityType>();
+        case EAbilityCategory::Stealth:  return StaticEnum<EStealthAbilityType>();
+        default:                         return nullptr;
+        }
+    }
+
+    /** Resolve a category name, or return Null */
+    EAbilityCategory ResolveCategory(const FString& Name)
+    {
+        const int64 Value = StaticEnum<EAbilityCategory>()->GetValueByNameString(Name);
+        return Value > 0 && Value < static_cast<int64>(EAbilityCategory::Max) ? static_cast<EAbilityCategory>(Value) : EAbilityCategory::Null;
+    }
+}
+
+UAbilityBuildOptimizerCommandlet::UAbilityBuildOptimizerCommandlet()
+{
+    IsClient = false;
+    IsServer = true;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UAbilityBuildOptimizerCommandlet::Main(const FString& Params)
+{
+    int32 NumCandidates = 1000000;
+    int32 TopCount = 20;
+    int32 Budget = 40;
+    int32 Seed = 1;
+    FParse::Value(*Params, TEXT("Candidates="), NumCandidates);
+    FParse::Value(*Params, TEXT("Top="), TopCount);
+    const bool bBudget = FParse::Value(*Params, TEXT("Budget="), Budget);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    NumCandidates = FMath::Max(NumCandidates, 1);
+    TopCount = FMath::Max(TopCount, 1);
+    Budget = FMath::Max(Budget, 0);
+
+    FAbilityBuildTuning Tuning = FAbilityBuildTuning::MakeDefault(Budget);
+    FString TuningPath;
+    if (FParse::Value(*Params, TEXT("Tuning="), TuningPath) && !LoadTuning(TuningPath, Tuning))
+    {
+        return 1;
+    }
+
+    // An explicit -Budget= wins over the tuning file.
+    if (bBudget)
+    {
+        Tuning.Budget = Budget;
+    }
+    Tuning.Budget = FMath::Max(Tuning.Budget, 0);
+
+    const FAbilityBuildOptimizer Optimizer(Tuning);
+    TArray<FAbilityPackedBuild> Builds;
+    TArray<FAbilityRankedBuild> Ranked;
+
+    const double GenerateStart = FPlatformTime::Seconds();
+    Optimizer.GenerateCandidates(NumCandidates, Seed, Builds);
+    const double GenerateSeconds = FPlatformTime::Seconds() - GenerateStart;
+
+    const double RankStart = FPlatformTime::Seconds();
+    Optimizer.Rank(Builds, TopCount, Ranked);
+    const double RankSeconds = FPlatformTime::Seconds() - RankStart;
+
+    const double BuildsPerSecond = NumCandidates / FMath::Max(RankSeconds, 1e-9);
+    UE_LOG(LogTemp, Display, TEXT("AbilityBuildOptimizer: %d candidates generated in %.2f ms, scored in %.2f ms (%.0f builds/s)"),
+        NumCandidates, GenerateSeconds * 1000.0, RankSeconds * 1000.0, BuildsPerSecond);
+
+    // Report the ranked builds with their non-zero allocations by name.
+    TArray<TSharedPtr<FJsonValue>> RankedJson;
+    for (int32 Rank = 0; Rank < Ranked.Num(); ++Rank)
+    {
+        const FAbilityPackedBuild& Build = Builds[Ranked[Rank].Index];
+        TSharedRef<FJsonObject> Allocation = MakeShared<FJsonObject>();
+        FString Summary;
+        for (int32 Category = 1; Category <= AbilityBuild::NumCategories; ++Category)
+        {
+            const EAbilityCategory CategoryValue = static_cast<EAbilityCategory>(Category);
+            const UEnum* TypeEnum = GetTypeEnum(CategoryValue);
+            for (int32 Type = 1; Type <= AbilityBuild::NumTypes(CategoryValue); ++Type)
+            {
+                const uint8 Points = Build.Points[AbilityBuild::SlotIndex(CategoryValue, static_cast<uint8>(Type))];
+                if (Points > 0)
+                {
+                    const FString Name = StaticEnum<EAbilityCategory>()->GetNameStringByValue(Category) + TEXT(".") + TypeEnum->GetNameStringByValue(Type);
+                    Allocation->SetNumberField(Name, Points);
+                    Summary += FString::Printf(TEXT(" %s=%d"), *Name, Points);
+                }
+            }
+        }
+
+        TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetNumberField(TEXT("rank"), Rank + 1);
+        Entry->SetNumberField(TEXT("score"), Ranked[Rank].Score);
+        Entry->SetObjectField(TEXT("allocation"), Allocation);
+        RankedJson.Add(MakeShared<FJsonValueObject>(Entry));
+
+        UE_LOG(LogTemp, Display, TEXT("#%d %.3f:%s"), Rank + 1, Ranked[Rank].Score, *Summary);
+    }
+
+    TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetNumberField(TEXT("candidates"), NumCandidates);
+    Report->SetNumberField(TEXT("budget"), Tuning.Budget);
+    Report->SetNumberField(TEXT("generateMs"), GenerateSeconds * 1000.0);
+    Report->SetNumberField(TEXT("scoreMs"), RankSeconds * 1000.0);
+    Report->SetNumberField(TEXT("buildsPerSecond"), BuildsPerSecond);
+    Report->SetArrayField(TEXT("ranked"), RankedJson);
+
+    FString OutputPath;
+    if (FParse::Value(*Params, TEXT("Output="), OutputPath))
+    {
+        FString Json;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+        FJsonSerializer::Serialize(Report, Writer);
+        if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("AbilityBuildOptimizer: failed to write '%s'."), *OutputPath);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+bool UAbilityBuildOptimizerCommandlet::LoadTuning(const FString& Filename, FAbilityBuildTuning& Tuning) const
+{
+    FString Text;
+    TSharedPtr<FJsonObject> Root;
+    if (!FFileHelper::LoadFileToString(Text, *Filename) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) || !Root)
+    {
+        UE_LOG(LogTemp, Error, TEXT("AbilityBuildOptimizer: unable to read tuning '%s'."), *Filename);
+        return false;
+    }
+
+    Root->TryGetNumberField(TEXT("Budget"), Tuning.Budget);
+
+    const TArray<TSharedPtr<FJsonValue>>* Modules = nullptr;
+    if (Root->TryGetArrayField(TEXT("Modules"), Modules))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *Modules)
+        {
+            const TSharedPtr<FJsonObject> Module = Value->AsObject();
+            const EAbilityCategory Category = Module ? ResolveCategory(Module->GetStringField(TEXT("Category"))) : EAbilityCategory::Null;
+            const int64 Type = Category != EAbilityCategory::Null ? GetTypeEnum(Category)->GetValueByNameString(Module->GetStringField(TEXT("Type"))) : INDEX_NONE;
+            if (Type <= 0 || Type > AbilityBuild::NumTypes(Category))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("AbilityBuildOptimizer: skipping unknown module in '%s'."), *Filename);
+                continue;
+            }
+
+            const int32 Slot = AbilityBuild::SlotIndex(Category, static_cast<uint8>(Type));
+            double Number = 0.0;
+            if (Module->TryGetNumberField(TEXT("Linear"), Number)) { Tuning.Linear[Slot] = static_cast<float>(Number); }
+            if (Module->TryGetNumberField(TEXT("Quadratic"), Number)) { Tuning.Quadratic[Slot] = static_cast<float>(Number); }
+            if (Module->TryGetNumberField(TEXT("MaxPoint"), Number)) { Tuning.MaxPoint[Slot] = static_cast<uint8>(FMath::Clamp(Number, 0.0, 127.0)); }
+        }
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Categories = nullptr;
+    if (Root->TryGetArrayField(TEXT("Categories"), Categories))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *Categories)
+        {
+            const TSharedPtr<FJsonObject> Entry = Value->AsObject();
+            const EAbilityCategory Category = Entry ? ResolveCategory(Entry->GetStringField(TEXT("Category"))) : EAbilityCategory::Null;
+            if (Category == EAbilityCategory::Null)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("AbilityBuildOptimizer: skipping unknown category in '%s'."), *Filename);
+                continue;
+            }
+
+            const int32 Index = static_cast<int32>(Category) - 1;
+            double Number = 0.0;
+            if (Entry->TryGetNumberField(TEXT("Threshold"), Number)) { Tuning.CategoryThreshold[Index] = static_cast<float>(Number); }
+            if (Entry->TryGetNumberField(TEXT("Bonus"), Number)) { Tuning.CategoryBonus[Index] = static_cast<float>(Number); }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AbilityBuildOptimizerCommandlet.generated.h"
+
+struct FAbilityBuildTuning;
+
+/**
+ * Headless search for dominant progression builds.
+ *
+ * Usage: -run=AbilityBuildOptimizer -nullrhi [-Tuning=Tuning.json] [-Candidates=1000000] [-Top=20]
+ *        [-Budget=40] [-Seed=1] [-Output=Ranked.json]
+ *
+ * Generates random builds within the budget, scores them with FAbilityBuildOptimizer and reports
+ * the ranked best builds together with the throughput in builds per second.
+ *
+ * Tuning file:
+ *   { "Budget": 40,
+ *     "Modules": [ { "Category": "Magical", "Type": "Fireball", "Linear": 2.0, "Quadratic": 0.1, "MaxPoint": 5 } ],
+ *     "Categories": [ { "Category": "Magical", "Threshold": 12, "Bonus": 8.0 } ] }
+ * Modules not listed keep the default tuning (one point per allocation, default caps). An explicit
+ * -Budget= overrides the file's Budget; -Candidates and -Top are clamped to at least 1.
+ */
+UCLASS()
+class UAbilityBuildOptimizerCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAbilityBuildOptimizerCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+
+    /** Apply a tuning file on top of the default tuning */
+    bool LoadTuning(const FString& Filename, FAbilityBuildTuning& Tuning) const;
+};
@@ -1,45 +1,165 @@
 #include "AbilityComponent.h"
+#include "AbilityAllocationSession.h"
+#include "AbilityDefinitionTable.h"
+#include "AbilityIndexSubsystem.h"
+#include "AbilityPrerequisiteGraph.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
+#include "UObject/UObjectIterator.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+namespace
+{
+    template<typename EnumType>
+    void WriteAbilityState(EAbilityGroup Group, const TMap<EnumType, FAbilityData>& Abilities, FAbilityStateReplica& State)
+    {
+        for (const TPair<EnumType, FAbilityData>& Pair : Abilities)
+        {
+            const int32 Slot = AbilitySlot::Index(Group, static_cast<uint8>(Pair.Key));
+            State.UnlockedMask |= Pair.Value.bUnlocked ? (1u << Slot) : 0u;
+            State.Levels[Slot] = static_cast<uint8>(FMath::Clamp(Pair.Value.Level, 0, 255));
+        }
+    }
+
+    template<typename EnumType>
+    void AddAbilityMapFootprint(EAbilityGroup Group, const TMap<EnumType, FAbilityData>& Abilities, FAbilityMemoryFootprint& Footprint)
+    {
+        Footprint.AbilityMaps[static_cast<int32>(Group)] += Abilities.GetAllocatedSize();
+        for (const TPair<EnumType, FAbilityData>& Pair : Abilities)
+        {
+            Footprint.Descriptions += Pair.Value.Description.GetAllocatedSize();
+        }
+    }
+
+    template<typename EnumType>
+    void ReadAbilityState(EAbilityGroup Group, TMap<EnumType, FAbilityData>& Abilities, const FAbilityStateReplica& State)
+    {
+        for (TPair<EnumType, FAbilityData>& Pair : Abilities)
+        {
+            const int32 Slot = AbilitySlot::Index(Group, static_cast<uint8>(Pair.Key));
+            Pair.Value.bUnlocked = (State.UnlockedMask & (1u << Slot)) != 0;
+            if (State.Levels.IsValidIndex(Slot))
+            {
+                Pair.Value.Level = State.Levels[Slot];
+            }
+        }
+    }
+}
 
 UAbilityComponent::UAbilityComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
+    SetIsReplicatedByDefault(true);
 }
 
 void UAbilityComponent::BeginPlay()
 {
     Super::BeginPlay();
+
+    if (GetOwnerRole() == ROLE_Authority)
+    {
+        RebuildAbilityState();
+    }
+
+    if (UAbilityIndexSubsystem* Index = GetWorld()->GetSubsystem<UAbilityIndexSubsystem>())
+    {
+        Index->Register(this, AbilityState.UnlockedMask);
+    }
+}
+
+void UAbilityComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UnregisterFromIndex();
+    Super::EndPlay(EndPlayReason);
+}
+
+void UAbilityComponent::OnUnregister()
+{
+    // Destroyed or unregistered without EndPlay; the index must not keep the component.
+    UnregisterFromIndex();
+    Super::OnUnregister();
+}
+
+void UAbilityComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    // Ability state is static most of the time, so it is only compared after an explicit dirty mark.
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+
+    DOREPLIFETIME_WITH_PARAMS_FAST(UAbilityComponent, AbilityState, Params);
+
+    Params.Condition = COND_OwnerOnly;
+    DOREPLIFETIME_WITH_PARAMS_FAST(UAbilityComponent, Progression, Params);
+}
+
+// ------------------ Memory ------------------
+
+void UAbilityComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+    Super::GetResourceSizeEx(CumulativeResourceSize);
+
+    FAbilityMemoryFootprint Footprint;
+    GetMemoryFootprint(Footprint);
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Footprint.GetHeapTotal());
+}
+
+void UAbilityComponent::GetMemoryFootprint(FAbilityMemoryFootprint& OutFootprint) const
+{
+    OutFootprint = FAbilityMemoryFootprint();
+    OutFootprint.NumComponents = 1;
+    OutFootprint.Objects = GetClass()->GetStructureSize();
+
+    AddAbilityMapFootprint(EAbilityGroup::Combat, CombatAbilities, OutFootprint);
+    AddAbilityMapFootprint(EAbilityGroup::Support, SupportAbilities, OutFootprint);
+    AddAbilityMapFootprint(EAbilityGroup::Movement, MovementAbilities, OutFootprint);
+    AddAbilityMapFootprint(EAbilityGroup::Control, ControlAbilities, OutFootprint);
+
+    for (int32 Category = static_cast<int32>(EAbilityCategory::Null) + 1; Category < static_cast<int32>(EAbilityCategory::Max); ++Category)
+    {
+        OutFootprint.ProgressionMaps[Category] = Progression.GetCategoryAllocatedSize(static_cast<EAbilityCategory>(Category));
+    }
+
+    OutFootprint.Journal = ProgressionJournal.GetAllocatedSize();
+    OutFootprint.Replication = AbilityState.Levels.GetAllocatedSize() + AbilityState.CooldownEndTimes.GetAllocatedSize();
+    OutFootprint.DerivedStats = DerivedStats.GetAllocatedSize();
 }
 
 // ------------------ Access ------------------
 
 FAbilityData UAbilityComponent::GetCombatAbility(ECombatAbility Ability) const
 {
-    const FAbilityData* Found = CombatAbilities.Find(Ability);
-    return Found ? *Found : FAbilityData();
+    ABILITY_SCOPE_OPERATION(Lookup, EAbilityGroup::Combat, Ability);
+    return WithDefinition(EAbilityGroup::Combat, static_cast<uint8>(Ability), CombatAbilities.Find(Ability));
 }
 
 FAbilityData UAbilityComponent::GetSupportAbility(ESupportAbility Ability) const
 {
-    const FAbilityData* Found = SupportAbilities.Find(Ability);
-    return Found ? *Found : FAbilityData();
+    ABILITY_SCOPE_OPERATION(Lookup, EAbilityGroup::Support, Ability);
+    return WithDefinition(EAbilityGroup::Support, static_cast<uint8>(Ability), SupportAbilities.Find(Ability));
 }
 
 FAbilityData UAbilityComponent::GetMovementAbility(EMovementAbility Ability) const
 {
-    const FAbilityData* Found = MovementAbilities.Find(Ability);
-    return Found ? *Found : FAbilityData();
+    ABILITY_SCOPE_OPERATION(Lookup, EAbilityGroup::Movement, Ability);
+    return WithDefinition(EAbilityGroup::Movement, static_cast<uint8>(Ability), MovementAbilities.Find(Ability));
 }
 
 FAbilityData UAbilityComponent::GetControlAbility(EControlAbility Ability) const
 {
-    const FAbilityData* Found = ControlAbilities.Find(Ability);
-    return Found ? *Found : FAbilityData();
+    ABILITY_SCOPE_OPERATION(Lookup, EAbilityGroup::Control, Ability);
+    return WithDefinition(EAbilityGroup::Control, static_cast<uint8>(Ability), ControlAbilities.Find(Ability));
 }
 
 // ------------------ Unlock Checks ------------------
 
 bool UAbilityComponent::IsCombatAbilityUnlocked(ECombatAbility Ability) const
 {
+    ABILITY_SCOPE_OPERATION(Lookup, EAbilityGroup::Combat, Ability);
     if (const FAbilityData* Found = CombatAbilities.Find(Ability))
     {
         return Found->bUnlocked;
@@ -49,6 +169,7 @@ bool UAbilityComponent::IsCombatAbilityUnlocked(ECombatAbility Ability) const
 
 bool UAbilityComponent::IsSupportAbilityUnlocked(ESupportAbility Ability) const
 {
+    ABILITY_SCOPE_OPERATION(Lookup, EAbilityGroup::Support, Ability);
     if (const FAbilityData* Found = SupportAbilities.Find(Ability))
     {
         return Found->bUnlocked;
@@ -58,6 +179,7 @@ bool UAbilityComponent::IsSupportAbilityUnlocked(ESupportAbility Ability) const
 
 bool UAbilityComponent::IsMovementAbilityUnlocked(EMovementAbility Ability) const
 {
+    ABILITY_SCOPE_OPERATION(Lookup, EAbilityGroup::Movement, Ability);
     if (const FAbilityData* Found = MovementAbilities.Find(Ability))
     {
         return Found->bUnlocked;
@@ -67,6 +189,7 @@ bool UAbilityComponent::IsMovementAbilityUnlocked(EMovementAbility Ability) cons
 
 bool UAbilityComponent::IsControlAbilityUnlocked(EControlAbility Ability) const
 {
+    ABILITY_SCOPE_OPERATION(Lookup, EAbilityGroup::Control, Ability);
     if (const FAbilityData* Found = ControlAbilities.Find(Ability))
     {
         return Found->bUnlocked;
@@ -74,13 +197,230 @@ bool UAbilityComponent::IsControlAbilityUnlocked(EControlAbility Ability) const
     return false;
 }
 
+// ------------------ Prerequisites ------------------
+
+bool UAbilityComponent::CanUnlockAbility(EAbilityGroup Group, uint8 Ability) const
+{
+    ABILITY_SCOPE_OPERATION(Validate, Group, Ability);
+    const FAbilityPrerequisiteGraph* Prerequisites = GetPrerequisites();
+    if (!Prerequisites || Ability >= AbilitySlot::GroupStride)
+    {
+        return true;
+    }
+    return Prerequisites->CanUnlock(AbilitySlot::Index(Group, Ability), AbilityState.UnlockedMask, AbilityState.Levels);
+}
+
+uint32 UAbilityComponent::GetAbilitiesAvailableAfterUnlock(EAbilityGroup Group, uint8 Ability) const
+{
+    const FAbilityPrerequisiteGraph* Prerequisites = GetPrerequisites();
+    if (!Prerequisites || Ability >= AbilitySlot::GroupStride)
+    {
+        return 0;
+    }
+
+    // Evaluate as if the ability were already unlocked.
+    const int32 Slot = AbilitySlot::Index(Group, Ability);
+    return Prerequisites->GetNewlyAvailable(Slot, AbilityState.UnlockedMask | (1u << Slot), AbilityState.Levels);
+}
+
+const FAbilityPrerequisiteGraph* UAbilityComponent::GetPrerequisites() const
+{
+    const FAbilityDefinitionRegistry::FTablePtr& Table = FAbilityDefinitionRegistry::GetTable();
+    if (!Table)
+    {
+        return nullptr;
+    }
+
+    const FAbilityPrerequisiteGraph* Prerequisites = Table->GetPrerequisites(ResolveDefinitionVariant(*Table));
+    return Prerequisites && Prerequisites->HasRequirements() ? Prerequisites : nullptr;
+}
+
+// ------------------ Tag Queries ------------------
+
+uint32 UAbilityComponent::GetUnlockedAbilitiesMatching(const FAbilityTagQuery& Query) const
+{
+    const FAbilityDefinitionRegistry::FTablePtr& Table = FAbilityDefinitionRegistry::GetTable();
+    if (!Table)
+    {
+        return 0;
+    }
+    return AbilityState.UnlockedMask & Query.GetMask(ResolveDefinitionVariant(*Table));
+}
+
+FAbilityTagQueryHandle UAbilityComponent::MakeAbilityTagQuery(const FGameplayTagQuery& Query)
+{
+    FAbilityTagQueryHandle Handle;
+    Handle.Query = MakeShared<FAbilityTagQuery>(Query);
+    return Handle;
+}
+
+bool UAbilityComponent::HasUnlockedAbilityMatchingHandle(const FAbilityTagQueryHandle& Query) const
+{
+    return Query.Query && AbilityState.UnlockedMask != 0 && HasUnlockedAbilityMatching(*Query.Query);
+}
+
+bool UAbilityComponent::HasUnlockedAbilityMatchingQuery(const FGameplayTagQuery& Query) const
+{
+    const FAbilityDefinitionRegistry::FTablePtr& Table = FAbilityDefinitionRegistry::GetTable();
+    if (!Table || AbilityState.UnlockedMask == 0)
+    {
+        return false;
+    }
+    return (AbilityState.UnlockedMask & Table->CompileTagQuery(ResolveDefinitionVariant(*Table), Query)) != 0;
+}
+
+// ------------------ Snapshot ------------------
+
+void UAbilityComponent::GetAbilitySnapshot(FAbilitySnapshot& OutSnapshot) const
+{
+    OutSnapshot.Levels.SetNumUninitialized(AbilitySlot::Num, EAllowShrinking::No);
+    OutSnapshot.CooldownRemaining.SetNumUninitialized(AbilitySlot::Num, EAllowShrinking::No);
+
+    // Clients see empty levels until the first replication.
+    if (AbilityState.Levels.Num() == AbilitySlot::Num)
+    {
+        FMemory::Memcpy(OutSnapshot.Levels.GetData(), AbilityState.Levels.GetData(), AbilitySlot::Num);
+    }
+    else
+    {
+        FMemory::Memzero(OutSnapshot.Levels.GetData(), AbilitySlot::Num);
+    }
+
+    // End times are in server time, so clients compare them against their estimate of it.
+    const double Now = GetServerTimeSeconds();
+    const TArray<double>& CooldownEndTimes = AbilityState.CooldownEndTimes;
+    const bool bHasCooldowns = CooldownEndTimes.Num() == AbilitySlot::Num;
+    uint32 ReadyMask = 0;
+    for (int32 Slot = 0; Slot < AbilitySlot::Num; ++Slot)
+    {
+        const double Remaining = bHasCooldowns ? FMath::Max(CooldownEndTimes[Slot] - Now, 0.0) : 0.0;
+        OutSnapshot.CooldownRemaining[Slot] = static_cast<float>(Remaining);
+        ReadyMask |= (Remaining <= 0.0 ? 1u : 0u) << Slot;
+    }
+
+    OutSnapshot.UnlockedMask = static_cast<int32>(AbilityState.UnlockedMask);
+    OutSnapshot.ReadyMask = static_cast<int32>(AbilityState.UnlockedMask & ReadyMask);
+}
+
+void UAbilityComponent::StartAbilityCooldown(EAbilityGroup Group, uint8 Ability)
+{
+    ABILITY_SCOPE_OPERATION(Activate, Group, Ability);
+    const FAbilityData* Found = nullptr;
+    switch (Group)
+    {
+    case EAbilityGroup::Combat:   Found = CombatAbilities.Find(static_cast<ECombatAbility>(Ability)); break;
+    case EAbilityGroup::Support:  Found = SupportAbilities.Find(static_cast<ESupportAbility>(Ability)); break;
+    case EAbilityGroup::Movement: Found = MovementAbilities.Find(static_cast<EMovementAbility>(Ability)); break;
+    case EAbilityGroup::Control:  Found = ControlAbilities.Find(static_cast<EControlAbility>(Ability)); break;
+    default: return;
+    }
+
+    if (GetOwnerRole() != ROLE_Authority || !Found || !Found->bUnlocked || Ability >= AbilitySlot::GroupStride || !GetWorld())
+    {
+        return;
+    }
+
+    if (AbilityState.CooldownEndTimes.Num() != AbilitySlot::Num)
+    {
+        AbilityState.CooldownEndTimes.SetNumZeroed(AbilitySlot::Num);
+    }
+
+    const FAbilityData Effective = WithDefinition(Group, Ability, Found);
+    AbilityState.CooldownEndTimes[AbilitySlot::Index(Group, Ability)] = GetServerTimeSeconds() + Effective.Cooldown;
+    MarkAbilityStateDirty();
+}
+
+double UAbilityComponent::GetServerTimeSeconds() const
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return 0.0;
+    }
+    const AGameStateBase* GameState = World->GetGameState();
+    return GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+}
+
+// ------------------ Derived Stats ------------------
+
+float UAbilityComponent::GetDerivedStat(FName Stat) const
+{
+    const FAbilityDefinitionRegistry::FTablePtr& Table = FAbilityDefinitionRegistry::GetTable();
+    return Table ? GetDerivedStatByIndex(Table->FindStat(Stat)) : 0.f;
+}
+
+float UAbilityComponent::GetDerivedStatByIndex(int32 Stat) const
+{
+    UpdateDerivedStats();
+    return DerivedStats.Get(Stat);
+}
+
+FAbilityDerivedStats& UAbilityComponent::GetDerivedStats() const
+{
+    // Binding marks every stat dirty, so a reload or a variant change is picked up by the next recompute.
+    const uint32 Version = FAbilityDefinitionRegistry::GetVersion();
+    if (DerivedStatsVersion != Version || DerivedStatsVariant != DefinitionVariant)
+    {
+        const FAbilityDefinitionRegistry::FTablePtr& Table = FAbilityDefinitionRegistry::GetTable();
+        DerivedStats.Bind(Table ? Table->GetStats(ResolveDefinitionVariant(*Table)) : nullptr);
+        DerivedStatsVersion = Version;
+        DerivedStatsVariant = DefinitionVariant;
+    }
+    return DerivedStats;
+}
+
+void UAbilityComponent::UpdateDerivedStats() const
+{
+    FAbilityDerivedStats& Stats = GetDerivedStats();
+    if (!Stats.IsDirty())
+    {
+        return;
+    }
+
+    ChangedDerivedStats |= Stats.Recompute([this](int32 Source) -> float
+    {
+        if (AbilityStatSource::IsProgression(Source))
+        {
+            return AbilityStatSource::GetProgressionValue(Progression, Source);
+        }
+
+        // Ability slots count their level while unlocked.
+        const bool bUnlocked = (AbilityState.UnlockedMask & (1u << Source)) != 0;
+        return bUnlocked && AbilityState.Levels.IsValidIndex(Source) ? AbilityState.Levels[Source] : 0.f;
+    });
+}
+
+void UAbilityComponent::ScheduleDerivedStatsUpdate()
+{
+    if (bDerivedStatsUpdatePending || !GetDerivedStats().IsDirty() || !GetWorld())
+    {
+        return;
+    }
+
+    bDerivedStatsUpdatePending = true;
+    GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UAbilityComponent::FlushDerivedStats);
+}
+
+void UAbilityComponent::FlushDerivedStats()
+{
+    bDerivedStatsUpdatePending = false;
+    UpdateDerivedStats();
+
+    if (ChangedDerivedStats != 0)
+    {
+        const uint64 Changed = ChangedDerivedStats;
+        ChangedDerivedStats = 0;
+        OnDerivedStatsChanged.Broadcast(Changed);
+    }
+}
+
 // ------------------ Unlock ------------------
 
 void UAbilityComponent::UnlockCombatAbility(ECombatAbility Ability)
 {
     if (FAbilityData* Found = CombatAbilities.Find(Ability))
     {
-        ApplyUnlock(*Found);
+        ApplyUnlock(EAbilityGroup::Combat, static_cast<uint8>(Ability), *Found);
     }
 }
 
@@ -88,7 +428,7 @@ void UAbilityComponent::UnlockSupportAbility(ESupportAbility Ability)
 {
     if (FAbilityData* Found = SupportAbilities.Find(Ability))
     {
-        ApplyUnlock(*Found);
+        ApplyUnlock(EAbilityGroup::Support, static_cast<uint8>(Ability), *Found);
     }
 }
 
@@ -96,7 +436,7 @@ void UAbilityComponent::UnlockMovementAbility(EMovementAbility Ability)
 {
     if (FAbilityData* Found = MovementAbilities.Find(Ability))
     {
-        ApplyUnlock(*Found);
+        ApplyUnlock(EAbilityGroup::Movement, static_cast<uint8>(Ability), *Found);
     }
 }
 
@@ -104,7 +444,7 @@ void UAbilityComponent::UnlockControlAbility(EControlAbility Ability)
 {
     if (FAbilityData* Found = ControlAbilities.Find(Ability))
     {
-        ApplyUnlock(*Found);
+        ApplyUnlock(EAbilityGroup::Control, static_cast<uint8>(Ability), *Found);
     }
 }
 
@@ -114,7 +454,7 @@ void UAbilityComponent::UpgradeCombatAbility(ECombatAbility Ability)
 {
     if (FAbilityData* Found = CombatAbilities.Find(Ability))
     {
-        ApplyUpgrade(*Found);
+        ApplyUpgrade(EAbilityGroup::Combat, static_cast<uint8>(Ability), *Found);
     }
 }
 
@@ -122,7 +462,7 @@ void UAbilityComponent::UpgradeSupportAbility(ESupportAbility Ability)
 {
     if (FAbilityData* Found = SupportAbilities.Find(Ability))
     {
-        ApplyUpgrade(*Found);
+        ApplyUpgrade(EAbilityGroup::Support, static_cast<uint8>(Ability), *Found);
     }
 }
 
@@ -130,7 +470,7 @@ void UAbilityComponent::UpgradeMovementAbility(EMovementAbility Ability)
 {
     if (FAbilityData* Found = MovementAbilities.Find(Ability))
     {
-        ApplyUpgrade(*Found);
+        ApplyUpgrade(EAbilityGroup::Movement, static_cast<uint8>(Ability), *Found);
     }
 }
 
@@ -138,19 +478,331 @@ void UAbilityComponent::UpgradeControlAbility(EControlAbility Ability)
 {
     if (FAbilityData* Found = ControlAbilities.Find(Ability))
     {
-        ApplyUpgrade(*Found);
+        ApplyUpgrade(EAbilityGroup::Control, static_cast<uint8>(Ability), *Found);
     }
 }
 
+// ------------------ Progression ------------------
+
+void UAbilityComponent::AllocateAbilityPoints(const TArray<FAbilityAllocationDelta>& Deltas)
+{
+    if (GetOwnerRole() == ROLE_Authority)
+    {
+        ApplyAllocation(Deltas);
+    }
+    else
+    {
+        ServerAllocateAbilityPoints(Deltas);
+    }
+}
+
+bool UAbilityComponent::CommitAllocation(FAbilityAllocationTransaction& Transaction)
+{
+    if (&Transaction.GetAbility() != &Progression)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Allocation transaction does not target this component's progression."));
+        return false;
+    }
+
+    TArray<FAbilityAllocationDelta> Deltas;
+    Transaction.GetDeltas(Deltas);
+    Transaction.Rollback();
+    if (Deltas.IsEmpty())
+    {
+        return true;
+    }
+
+    if (GetOwnerRole() == ROLE_Authority)
+    {
+        return ApplyAllocation(Deltas);
+    }
+    ServerAllocateAbilityPoints(Deltas);
+    return true;
+}
+
+bool UAbilityComponent::CommitAllocation(FAbilityAllocationSession& Session)
+{
+    if (&Session.GetAbility() != &Progression)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Allocation session does not target this component's progression."));
+        return false;
+    }
+
+    TArray<FAbilityAllocationDelta> Deltas;
+    Session.GetDeltas(Deltas);
+    Session.Cancel();
+    if (Deltas.IsEmpty())
+    {
+        return true;
+    }
+
+    if (GetOwnerRole() == ROLE_Authority)
+    {
+        return ApplyAllocation(Deltas);
+    }
+    ServerAllocateAbilityPoints(Deltas);
+    return true;
+}
+
+bool UAbilityComponent::ServerAllocateAbilityPoints_Validate(const TArray<FAbilityAllocationDelta>& Deltas)
+{
+    ABILITY_SCOPE_OPERATION(Validate, EAbilityGroup::Max, 0);
+    // Oversized batches can only come from a tampered client; regular invalid batches are just rejected.
+    return Deltas.Num() <= FAbility::MaxAllocationBatchSize;
+}
+
+void UAbilityComponent::ServerAllocateAbilityPoints_Implementation(const TArray<FAbilityAllocationDelta>& Deltas)
+{
+    ApplyAllocation(Deltas);
+}
+
+bool UAbilityComponent::IncreaseProgressionAbility(EAbilityCategory Category, uint8 Type)
+{
+    if (!Progression.IncreaseAbilityByCategory(Category, Type))
+    {
+        return false;
+    }
+    OnProgressionModuleChanged(Category, Type);
+    return true;
+}
+
+bool UAbilityComponent::DecreaseProgressionAbility(EAbilityCategory Category, uint8 Type)
+{
+    if (!Progression.DecreaseAbilityByCategory(Category, Type))
+    {
+        return false;
+    }
+    OnProgressionModuleChanged(Category, Type);
+    return true;
+}
+
+void UAbilityComponent::RespecProgression()
+{
+    Progression.ResetAllAbilities();
+    ProgressionJournal.AppendRespec();
+    CompactJournalIfNeeded();
+    MarkProgressionDirty();
+
+    GetDerivedStats().InvalidateProgression();
+    ScheduleDerivedStatsUpdate();
+}
+
+void UAbilityComponent::SetProgression(const FAbility& NewProgression)
+{
+    Progression = NewProgression;
+    ProgressionJournal.Compact(Progression);
+    MarkProgressionDirty();
+
+    GetDerivedStats().InvalidateProgression();
+    ScheduleDerivedStatsUpdate();
+    OnProgressionReplaced.Broadcast();
+}
+
+bool UAbilityComponent::ApplyAllocation(const TArray<FAbilityAllocationDelta>& Deltas)
+{
+    if (!Progression.ApplyAllocationBatch(Deltas))
+    {
+        return false;
+    }
+
+    // Entries carry absolute module state, so a module listed twice is harmless.
+    FAbilityDerivedStats& Stats = GetDerivedStats();
+    for (const FAbilityAllocationDelta& Entry : Deltas)
+    {
+        if (const FAbilityModule* Module = Progression.FindModule(Entry.Category, Entry.Type))
+        {
+            ProgressionJournal.AppendModule(Entry.Category, Entry.Type, *Module);
+            Stats.Invalidate(AbilityStatSource::Progression(Entry.Category, Entry.Type));
+        }
+    }
+    ProgressionJournal.AppendPool(Progression);
+    CompactJournalIfNeeded();
+    MarkProgressionDirty();
+    ScheduleDerivedStatsUpdate();
+    return true;
+}
+
+void UAbilityComponent::OnProgressionModuleChanged(EAbilityCategory Category, uint8 Type)
+{
+    if (const FAbilityModule* Module = Progression.FindModule(Category, Type))
+    {
+        ProgressionJournal.AppendModule(Category, Type, *Module);
+        GetDerivedStats().Invalidate(AbilityStatSource::Progression(Category, Type));
+        ScheduleDerivedStatsUpdate();
+    }
+    ProgressionJournal.AppendPool(Progression);
+    CompactJournalIfNeeded();
+    MarkProgressionDirty();
+}
+
+void UAbilityComponent::CompactJournalIfNeeded()
+{
+    if (!ProgressionJournal.NeedsCompaction())
+    {
+        return;
+    }
+
+    // Storage flushes and compacts from the broadcast; without it the log is folded here so it stays bounded.
+    OnProgressionJournalFull.Broadcast();
+    if (ProgressionJournal.NeedsCompaction())
+    {
+        ProgressionJournal.Compact(Progression);
+    }
+}
+
+// ------------------ Replication ------------------
+
+void UAbilityComponent::OnRep_AbilityState()
+{
+    ReadAbilityState(EAbilityGroup::Combat, CombatAbilities, AbilityState);
+    ReadAbilityState(EAbilityGroup::Support, SupportAbilities, AbilityState);
+    ReadAbilityState(EAbilityGroup::Movement, MovementAbilities, AbilityState);
+    ReadAbilityState(EAbilityGroup::Control, ControlAbilities, AbilityState);
+    NotifyUnlockedMaskChanged();
+
+    GetDerivedStats().InvalidateAll();
+    ScheduleDerivedStatsUpdate();
+}
+
+void UAbilityComponent::OnRep_Progression()
+{
+    GetDerivedStats().InvalidateProgression();
+    ScheduleDerivedStatsUpdate();
+    OnProgressionReplaced.Broadcast();
+}
+
+void UAbilityComponent::RebuildAbilityState()
+{
+    AbilityState.UnlockedMask = 0;
+    AbilityState.Levels.SetNumZeroed(AbilitySlot::Num);
+    WriteAbilityState(EAbilityGroup::Combat, CombatAbilities, AbilityState);
+    WriteAbilityState(EAbilityGroup::Support, SupportAbilities, AbilityState);
+    WriteAbilityState(EAbilityGroup::Movement, MovementAbilities, AbilityState);
+    WriteAbilityState(EAbilityGroup::Control, ControlAbilities, AbilityState);
+    MarkAbilityStateDirty();
+    NotifyUnlockedMaskChanged();
+
+    GetDerivedStats().InvalidateAll();
+    ScheduleDerivedStatsUpdate();
+}
+
+void UAbilityComponent::UpdateAbilityState(EAbilityGroup Group, uint8 Index, const FAbilityData& Ability)
+{
+    const int32 Slot = AbilitySlot::Index(Group, Index);
+    if (AbilityState.Levels.Num() != AbilitySlot::Num)
+    {
+        AbilityState.Levels.SetNumZeroed(AbilitySlot::Num);
+    }
+
+    const uint32 Bit = 1u << Slot;
+    const uint32 OldMask = AbilityState.UnlockedMask;
+    AbilityState.UnlockedMask = Ability.bUnlocked ? (OldMask | Bit) : (OldMask & ~Bit);
+    AbilityState.Levels[Slot] = static_cast<uint8>(FMath::Clamp(Ability.Level, 0, 255));
+    MarkAbilityStateDirty();
+
+    if (AbilityState.UnlockedMask != OldMask)
+    {
+        NotifyUnlockedMaskChanged();
+    }
+
+    GetDerivedStats().Invalidate(AbilityStatSource::Slot(Slot));
+    ScheduleDerivedStatsUpdate();
+}
+
+void UAbilityComponent::UnregisterFromIndex()
+{
+    if (AbilityIndexHandle == INDEX_NONE)
+    {
+        return;
+    }
+
+    const UWorld* World = GetWorld();
+    if (UAbilityIndexSubsystem* Index = World ? World->GetSubsystem<UAbilityIndexSubsystem>() : nullptr)
+    {
+        Index->Unregister(this);
+    }
+}
+
+void UAbilityComponent::NotifyUnlockedMaskChanged()
+{
+    if (AbilityIndexHandle == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (UAbilityIndexSubsystem* Index = GetWorld()->GetSubsystem<UAbilityIndexSubsystem>())
+    {
+        Index->UpdateUnlockedMask(this, AbilityState.UnlockedMask);
+    }
+}
+
+void UAbilityComponent::MarkAbilityStateDirty()
+{
+    MARK_PROPERTY_DIRTY_FROM_NAME(UAbilityComponent, AbilityState, this);
+}
+
+void UAbilityComponent::MarkProgressionDirty()
+{
+    MARK_PROPERTY_DIRTY_FROM_NAME(UAbilityComponent, Progression, this);
+}
+
 // ------------------ Internal ------------------
 
-void UAbilityComponent::ApplyUnlock(FAbilityData& Ability)
+int32 UAbilityComponent::ResolveDefinitionVariant(const FAbilityDefinitionTable& Table) const
+{
+    // Re-resolve the variant only after a reload published a new table or DefinitionVariant was changed.
+    const uint32 Version = FAbilityDefinitionRegistry::GetVersion();
+    if (DefinitionVersion != Version || ResolvedDefinitionVariant != DefinitionVariant)
+    {
+        DefinitionVariantIndex = Table.FindVariant(DefinitionVariant);
+        if (DefinitionVariantIndex == INDEX_NONE)
+        {
+            DefinitionVariantIndex = Table.FindVariant(TEXT("Default"));
+        }
+        DefinitionVersion = Version;
+        ResolvedDefinitionVariant = DefinitionVariant;
+    }
+    return DefinitionVariantIndex;
+}
+
+FAbilityData UAbilityComponent::WithDefinition(EAbilityGroup Group, uint8 Index, const FAbilityData* Found) const
 {
-    Ability.bUnlocked = true;
+    FAbilityData Result = Found ? *Found : FAbilityData();
+
+    const FAbilityDefinitionRegistry::FTablePtr& Table = FAbilityDefinitionRegistry::GetTable();
+    if (!Table)
+    {
+        return Result;
+    }
+
+    if (const FAbilityDefinition* Definition = Table->Find(ResolveDefinitionVariant(*Table), Group, Index))
+    {
+        Result.Cooldown = Definition->Cooldown;
+        Result.EnergyCost = Definition->EnergyCost;
+        Result.Description = Definition->Description;
+    }
+    return Result;
+}
+
+void UAbilityComponent::ApplyUnlock(EAbilityGroup Group, uint8 Index, FAbilityData& Ability)
+{
+    ABILITY_SCOPE_OPERATION(Unlock, Group, Index);
+    if (!Ability.bUnlocked && !CanUnlockAbility(Group, Index))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot unlock ability %d of group %d: prerequisites not met."), Index, static_cast<int32>(Group));
+        return;
+    }
+
+    if (!Ability.bUnlocked)
+    {
+        Ability.bUnlocked = true;
+        UpdateAbilityState(Group, Index, Ability);
+    }
 }
 
-void UAbilityComponent::ApplyUpgrade(FAbilityData& Ability)
+void UAbilityComponent::ApplyUpgrade(EAbilityGroup Group, uint8 Index, FAbilityData& Ability)
 {
+    ABILITY_SCOPE_OPERATION(Upgrade, Group, Index);
     if (Ability.bUnlocked)
     {
         int32 Current = static_cast<int32>(Ability.Level);
@@ -158,6 +810,59 @@ void UAbilityComponent::ApplyUpgrade(FAbilityData& Ability)
         if (Current < Max)
         {
             Ability.Level = static_cast<EAbilityLevel>(Current + 1);
+            UpdateAbilityState(Group, Index, Ability);
         }
     }
 }
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GAbilityMemReportCommand(
+    TEXT("Ability.MemReport"),
+    TEXT("Report the memory owned by the ability components of the current world by allocation kind and category. Add 'Detailed' to list every component."),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        const bool bDetailed = Args.ContainsByPredicate([](const FString& Arg) { return Arg.Equals(TEXT("Detailed"), ESearchCase::IgnoreCase); });
+
+        FAbilityMemoryFootprint Total;
+        for (TObjectIterator<UAbilityComponent> It; It; ++It)
+        {
+            const UAbilityComponent* Component = *It;
+            if (Component->IsTemplate() || Component->GetWorld() != World)
+            {
+                continue;
+            }
+
+            FAbilityMemoryFootprint Footprint;
+            Component->GetMemoryFootprint(Footprint);
+            Total += Footprint;
+
+            if (bDetailed)
+            {
+                Ar.Logf(TEXT("  %s: %llu B (%llu B heap)"), *Component->GetPathName(), static_cast<uint64>(Footprint.GetTotal()), static_cast<uint64>(Footprint.GetHeapTotal()));
+            }
+        }
+
+        const int32 NumComponents = FMath::Max(Total.NumComponents, 1);
+        auto Line = [&Ar, NumComponents](const TCHAR* Kind, SIZE_T Bytes)
+        {
+            Ar.Logf(TEXT("  %-24s %12llu B  %10.1f B/component"), Kind, static_cast<uint64>(Bytes), static_cast<double>(Bytes) / NumComponents);
+        };
+
+        Ar.Logf(TEXT("Ability memory in %s: %d components, %llu B total"), World ? *World->GetName() : TEXT("<no world>"), Total.NumComponents, static_cast<uint64>(Total.GetTotal()));
+        Line(TEXT("Objects"), Total.Objects);
+
+        const UEnum* GroupEnum = StaticEnum<EAbilityGroup>();
+        for (int32 Group = 0; Group < static_cast<int32>(EAbilityGroup::Max); ++Group)
+        {
+            Line(*FString::Printf(TEXT("AbilityMap.%s"), *GroupEnum->GetNameStringByValue(Group)), Total.AbilityMaps[Group]);
+        }
+        Line(TEXT("Descriptions"), Total.Descriptions);
+
+        const UEnum* CategoryEnum = StaticEnum<EAbilityCategory>();
+        for (int32 Category = static_cast<int32>(EAbilityCategory::Null) + 1; Category < static_cast<int32>(EAbilityCategory::Max); ++Category)
+        {
+            Line(*FString::Printf(TEXT("Progression.%s"), *CategoryEnum->GetNameStringByValue(Category)), Total.ProgressionMaps[Category]);
+        }
+        Line(TEXT("Journal"), Total.Journal);
+        Line(TEXT("Replication"), Total.Replication);
+        Line(TEXT("DerivedStats"), Total.DerivedStats);
+    }));
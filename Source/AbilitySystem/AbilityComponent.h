@@ -3,8 +3,102 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "AbilityType.h"
+#include "AbilityData.h"
+#include "AbilityJournal.h"
+#include "AbilityDerivedStats.h"
+#include "GameplayTagContainer.h"
 #include "AbilityComponent.generated.h"
 
+class FAbilityAllocationSession;
+class FAbilityAllocationTransaction;
+class FAbilityDefinitionTable;
+class FAbilityPrerequisiteGraph;
+class FAbilityTagQuery;
+
+/**
+ * Memory owned by ability components, by allocation kind. Heap sizes are allocated (not used)
+ * bytes; shared definition tables are not included. Active effects live in the per-world
+ * UAbilityEffectSubsystem rather than on the component and are not included either.
+ */
+struct FAbilityMemoryFootprint
+{
+    /** Number of components summed into this footprint */
+    int32 NumComponents = 0;
+
+    /** sizeof(UAbilityComponent) per component; fixed-size members (masks, pending state) are counted only here */
+    SIZE_T Objects = 0;
+
+    /** Ability map allocations, per EAbilityGroup */
+    SIZE_T AbilityMaps[static_cast<int32>(EAbilityGroup::Max)] = {};
+
+    /** Description strings held by the ability maps */
+    SIZE_T Descriptions = 0;
+
+    /** FAbility module map allocations, per EAbilityCategory; Null stays 0 */
+    SIZE_T ProgressionMaps[static_cast<int32>(EAbilityCategory::Max)] = {};
+
+    /** Progression journal snapshot and log */
+    SIZE_T Journal = 0;
+
+    /** Replicated slot state: levels and cooldown end times */
+    SIZE_T Replication = 0;
+
+    /** Cached derived stat values */
+    SIZE_T DerivedStats = 0;
+
+    /** Heap bytes of every kind */
+    SIZE_T GetHeapTotal() const
+    {
+        SIZE_T Total = Descriptions + Journal + Replication + DerivedStats;
+        for (SIZE_T Size : AbilityMaps)
+        {
+            Total += Size;
+        }
+        for (SIZE_T Size : ProgressionMaps)
+        {
+            Total += Size;
+        }
+        return Total;
+    }
+
+    /** Heap bytes plus the component objects themselves */
+    SIZE_T GetTotal() const { return Objects + GetHeapTotal(); }
+
+    FAbilityMemoryFootprint& operator+=(const FAbilityMemoryFootprint& Other)
+    {
+        NumComponents += Other.NumComponents;
+        Objects += Other.Objects;
+        for (int32 Index = 0; Index < UE_ARRAY_COUNT(AbilityMaps); ++Index)
+        {
+            AbilityMaps[Index] += Other.AbilityMaps[Index];
+        }
+        Descriptions += Other.Descriptions;
+        for (int32 Index = 0; Index < UE_ARRAY_COUNT(ProgressionMaps); ++Index)
+        {
+            ProgressionMaps[Index] += Other.ProgressionMaps[Index];
+        }
+        Journal += Other.Journal;
+        Replication += Other.Replication;
+        DerivedStats += Other.DerivedStats;
+        return *this;
+    }
+};
+
+/**
+ * Blueprint handle to a compiled FAbilityTagQuery. Make it once with MakeAbilityTagQuery and keep it
+ * in a variable; every test through it is then a mask AND, recompiled only after a definition reload.
+ */
+USTRUCT(BlueprintType)
+struct YOURGAME_API FAbilityTagQueryHandle
+{
+    GENERATED_BODY()
+
+    TSharedPtr<FAbilityTagQuery> Query;
+};
+
+/** Bits (by FAbilityDefinitionTable stat index) of the derived stats whose value changed */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAbilityDerivedStatsChanged, uint64 /* ChangedStats */);
+
 /**
  * Component responsible for managing character abilities: combat, support, movement, control, etc.
  */
@@ -13,13 +107,25 @@ class YOURGAME_API UAbilityComponent : public UActorComponent
 {
     GENERATED_BODY()
 
+    friend class UAbilityIndexSubsystem;
+
 public:
     UAbilityComponent();
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void OnUnregister() override;
 
 public:
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    /** Reports the heap owned by the ability maps, progression, journal and caches to memory reports */
+    virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+    /** Memory owned by this component, by allocation kind. Console: Ability.MemReport [Detailed] */
+    void GetMemoryFootprint(FAbilityMemoryFootprint& OutFootprint) const;
+
     // ------------------ Ability Access ------------------
 
     /** Get data of a combat ability */
@@ -56,6 +162,50 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Ability|Control")
     bool IsControlAbilityUnlocked(EControlAbility Ability) const;
 
+    /** Unlock bit per flat ability slot (see AbilitySlot) */
+    uint32 GetUnlockedMask() const { return AbilityState.UnlockedMask; }
+
+    /** Check if the prerequisites of an ability are met; abilities without prerequisites always pass */
+    UFUNCTION(BlueprintCallable, Category = "Ability")
+    bool CanUnlockAbility(EAbilityGroup Group, uint8 Ability) const;
+
+    /** Locked abilities, as slot bits, whose last missing prerequisite is the given ability */
+    uint32 GetAbilitiesAvailableAfterUnlock(EAbilityGroup Group, uint8 Ability) const;
+
+    /** Unlocked abilities whose definition tags match a compiled query, as slot bits */
+    uint32 GetUnlockedAbilitiesMatching(const FAbilityTagQuery& Query) const;
+
+    /** True if any unlocked ability matches a compiled query; a single AND once the query is compiled */
+    bool HasUnlockedAbilityMatching(const FAbilityTagQuery& Query) const { return GetUnlockedAbilitiesMatching(Query) != 0; }
+
+    /** Compile a tag query once for HasUnlockedAbilityMatchingHandle */
+    UFUNCTION(BlueprintPure, Category = "Ability")
+    static FAbilityTagQueryHandle MakeAbilityTagQuery(const FGameplayTagQuery& Query);
+
+    /** Check if any unlocked ability's definition tags match a compiled query; false for an empty handle */
+    UFUNCTION(BlueprintCallable, Category = "Ability")
+    bool HasUnlockedAbilityMatchingHandle(const FAbilityTagQueryHandle& Query) const;
+
+    /** Check if any unlocked ability's definition tags match the query; compiles the query on every call */
+    UFUNCTION(BlueprintCallable, Category = "Ability", meta = (DeprecatedFunction, DeprecationMessage = "Compiles the query on every call; keep a MakeAbilityTagQuery handle and use HasUnlockedAbilityMatchingHandle."))
+    bool HasUnlockedAbilityMatchingQuery(const FGameplayTagQuery& Query) const;
+
+    /** Fill unlock state, levels and readiness of every ability in one call; the snapshot's storage is reused */
+    UFUNCTION(BlueprintCallable, Category = "Ability")
+    void GetAbilitySnapshot(UPARAM(ref) FAbilitySnapshot& OutSnapshot) const;
+
+    // ------------------ Derived Stats ------------------
+
+    /** Derived modifier (e.g. "Damage", "MoveSpeed") summed from ability levels and progression points; 0 if the stat is unknown */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Stats")
+    float GetDerivedStat(FName Stat) const;
+
+    /** Derived modifier by its index in the current definition table (see FAbilityDefinitionTable::FindStat) */
+    float GetDerivedStatByIndex(int32 Stat) const;
+
+    /** Broadcast at most once per frame, after the changes of the frame were recomputed */
+    FOnAbilityDerivedStatsChanged OnDerivedStatsChanged;
+
     // ------------------ Ability Management ------------------
 
     /** Unlock a combat ability */
@@ -90,8 +240,70 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Ability|Control")
     void UpgradeControlAbility(EControlAbility Ability);
 
+    /** Put an unlocked ability on cooldown for its effective Cooldown; the end time replicates with the slot state */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Ability")
+    void StartAbilityCooldown(EAbilityGroup Group, uint8 Ability);
+
+    // ------------------ Progression ------------------
+
+    /** Allocate or refund progression points in one transaction; sent to the server as a single RPC when called on a client */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Progression")
+    void AllocateAbilityPoints(const TArray<FAbilityAllocationDelta>& Deltas);
+
+    /**
+     * Commit a transaction or session staged over this component's progression through AllocateAbilityPoints,
+     * then clear it. Returns false if it targets another FAbility or the authority rejected the batch; a
+     * client returns true once the batch is sent.
+     */
+    bool CommitAllocation(FAbilityAllocationTransaction& Transaction);
+    bool CommitAllocation(FAbilityAllocationSession& Session);
+
+    /** Spend one allocated point on a progression module; returns true if it changed */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Ability|Progression")
+    bool IncreaseProgressionAbility(EAbilityCategory Category, uint8 Type);
+
+    /** Take one active point back from a progression module; returns true if it changed */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Ability|Progression")
+    bool DecreaseProgressionAbility(EAbilityCategory Category, uint8 Type);
+
+    /** Reset every progression module and refund the whole pool; constant time regardless of how many modules were progressed */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Ability|Progression")
+    void RespecProgression();
+
+    /** Character progression: point pool and per-category ability modules */
+    const FAbility& GetProgression() const { return Progression; }
+
+    /** Replace the progression, e.g. when a character materialized from storage logs in; restarts the journal from it */
+    void SetProgression(const FAbility& NewProgression);
+
+    /** Mutations applied to the progression since the last compaction */
+    FAbilityJournal& GetProgressionJournal() { return ProgressionJournal; }
+
+    /**
+     * Broadcast once the journal reaches its compaction threshold, so storage can flush the log and
+     * compact it. If the journal still needs compaction after the broadcast, the component compacts it.
+     */
+    FSimpleMulticastDelegate OnProgressionJournalFull;
+
+    /** Broadcast after the progression was replaced wholesale (replication, SetProgression); open FAbilityAllocationSessions should Revalidate */
+    FSimpleMulticastDelegate OnProgressionReplaced;
+
 protected:
 
+    // ------------------ Network ------------------
+
+    /** Server side of AllocateAbilityPoints; the batch is applied atomically or rejected as a whole */
+    UFUNCTION(Server, Reliable, WithValidation)
+    void ServerAllocateAbilityPoints(const TArray<FAbilityAllocationDelta>& Deltas);
+
+    /** Push replicated ability slot state back into the ability maps */
+    UFUNCTION()
+    void OnRep_AbilityState();
+
+    /** Invalidate the derived stats that read progression */
+    UFUNCTION()
+    void OnRep_Progression();
+
     // ------------------ Storage ------------------
 
     /** Combat ability map */
@@ -110,11 +322,98 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Abilities|Control")
     TMap<EControlAbility, FAbilityData> ControlAbilities;
 
+    /** Definition table variant supplying Cooldown, EnergyCost and Description; falls back to "Default" */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Abilities|Definitions")
+    FName DefinitionVariant = TEXT("Default");
+
+    /** Point pool and per-category ability progression; written only through the progression functions so changes replicate and journal */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, ReplicatedUsing = OnRep_Progression, Category = "Abilities|Progression")
+    FAbility Progression;
+
+    /** Unlock bits and levels of every ability slot; the maps themselves cannot replicate */
+    UPROPERTY(ReplicatedUsing = OnRep_AbilityState)
+    FAbilityStateReplica AbilityState;
+
+    /** Rebuild the replicated slot state from the ability maps, e.g. after a subclass rewrote them */
+    void RebuildAbilityState();
+
 private:
 
+    /** Index of DefinitionVariant (or "Default") in the table, re-resolved after a reload or a variant change */
+    int32 ResolveDefinitionVariant(const FAbilityDefinitionTable& Table) const;
+
+    /** Prerequisites of DefinitionVariant in the current definition table, or nullptr */
+    const FAbilityPrerequisiteGraph* GetPrerequisites() const;
+
+    /** Overlay tuning from the current definition table onto per-component data */
+    FAbilityData WithDefinition(EAbilityGroup Group, uint8 Index, const FAbilityData* Found) const;
+
     /** Safely upgrade ability level */
-    void ApplyUpgrade(FAbilityData& Ability);
+    void ApplyUpgrade(EAbilityGroup Group, uint8 Index, FAbilityData& Ability);
 
     /** Internal unlock logic */
-    void ApplyUnlock(FAbilityData& Ability);
+    void ApplyUnlock(EAbilityGroup Group, uint8 Index, FAbilityData& Ability);
+
+    /** Mirror one slot into the replicated state and mark it dirty for push-model replication */
+    void UpdateAbilityState(EAbilityGroup Group, uint8 Index, const FAbilityData& Ability);
+
+    /** World time as seen by the server; cooldown end times are stored in it */
+    double GetServerTimeSeconds() const;
+
+    /** Forward the unlocked mask to the world ability index */
+    void NotifyUnlockedMaskChanged();
+
+    /** Leave UAbilityIndexSubsystem if registered */
+    void UnregisterFromIndex();
+
+    /** Apply an allocation batch and record the touched modules; returns false if the batch was rejected */
+    bool ApplyAllocation(const TArray<FAbilityAllocationDelta>& Deltas);
+
+    /** Journal a changed progression module and mark progression dirty */
+    void OnProgressionModuleChanged(EAbilityCategory Category, uint8 Type);
+
+    /** Hand a full journal to OnProgressionJournalFull, then fold it into its snapshot if nobody did */
+    void CompactJournalIfNeeded();
+
+    /** Mark the replicated slot state dirty for push-model replication */
+    void MarkAbilityStateDirty();
+
+    /** Mark progression dirty for push-model replication */
+    void MarkProgressionDirty();
+
+    /** Derived stat cache bound to the stat table of the current definitions, rebound after a reload */
+    FAbilityDerivedStats& GetDerivedStats() const;
+
+    /** Recompute the invalidated derived stats now, e.g. when one is read before the scheduled update */
+    void UpdateDerivedStats() const;
+
+    /** Coalesce invalidated derived stats into a single recompute on the next tick */
+    void ScheduleDerivedStatsUpdate();
+
+    /** Next-tick recompute; broadcasts OnDerivedStatsChanged */
+    void FlushDerivedStats();
+
+    /** Append-only record of progression changes for incremental persistence */
+    FAbilityJournal ProgressionJournal;
+
+    /** Definition table version DefinitionVariantIndex was resolved against */
+    mutable uint32 DefinitionVersion = 0;
+
+    /** Index of DefinitionVariant in the current definition table, and the variant name it was resolved for */
+    mutable int32 DefinitionVariantIndex = INDEX_NONE;
+    mutable FName ResolvedDefinitionVariant;
+
+    /** Handle assigned by UAbilityIndexSubsystem while registered */
+    int32 AbilityIndexHandle = INDEX_NONE;
+
+    /** Cached derived stats and the definition table version and variant they are bound to */
+    mutable FAbilityDerivedStats DerivedStats;
+    mutable uint32 DerivedStatsVersion = 0;
+    mutable FName DerivedStatsVariant;
+
+    /** Stats changed by recomputes since the last OnDerivedStatsChanged */
+    mutable uint64 ChangedDerivedStats = 0;
+
+    /** True while a next-tick recompute is scheduled */
+    bool bDerivedStatsUpdatePending = false;
 };
@@ -0,0 +1,56 @@
+#include "AbilityDefinitionImportCommandlet.h"
+#include "AbilityDefinitionTable.h"
+
+UAbilityDefinitionImportCommandlet::UAbilityDefinitionImportCommandlet()
+{
+    IsClient = false;
+    IsServer = true;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UAbilityDefinitionImportCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Files;
+    const TCHAR* Stream = *Params;
+    FString File;
+    // Match the switch with its dash so -OutputFile= and similar are not taken for a file.
+    while (FParse::Value(Stream, TEXT("-File="), File))
+    {
+        Files.Add(File);
+        Stream = FCString::Strifind(Stream, TEXT("-File=")) + 6;
+    }
+
+    if (Files.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("AbilityDefinitionImport: no -File= given."));
+        return 1;
+    }
+
+    FAbilityDefinitionTable Table;
+    FAbilityDefinitionImporter Importer;
+    int32 TotalRows = 0;
+    const double TotalStart = FPlatformTime::Seconds();
+
+    for (const FString& Filename : Files)
+    {
+        FString Error;
+        const double Start = FPlatformTime::Seconds();
+        if (!Importer.ImportFile(Filename, Table, Error))
+        {
+            UE_LOG(LogTemp, Error, TEXT("AbilityDefinitionImport: %s"), *Error);
+            return 1;
+        }
+        const double Seconds = FPlatformTime::Seconds() - Start;
+
+        TotalRows += Importer.GetNumRows();
+        UE_LOG(LogTemp, Display, TEXT("AbilityDefinitionImport: %s: %d rows (%d skipped) in %.2f ms, %.0f rows/s"),
+            *Filename, Importer.GetNumRows(), Importer.GetNumSkipped(), Seconds * 1000.0, Importer.GetNumRows() / FMath::Max(Seconds, 1e-9));
+    }
+
+    Table.Compile();
+
+    UE_LOG(LogTemp, Display, TEXT("AbilityDefinitionImport: %d rows, %d variants, %d defined slots, %d derived stats in %.2f ms"),
+        TotalRows, Table.GetNumVariants(), Table.GetNumDefined(), Table.GetNumStats(), (FPlatformTime::Seconds() - TotalStart) * 1000.0);
+    return 0;
+}
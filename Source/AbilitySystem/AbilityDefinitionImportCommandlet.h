@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AbilityDefinitionImportCommandlet.generated.h"
+
+/**
+ * Headless import of ability definition tables.
+ *
+ * Usage: -run=AbilityDefinitionImport -nullrhi -File=Definitions.csv [-File=More.json ...]
+ *
+ * Streams every file into one flat definition table and reports row counts and timing.
+ */
+UCLASS()
+class UAbilityDefinitionImportCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAbilityDefinitionImportCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,701 @@
+#include "AbilityDefinitionTable.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+
+static_assert(AbilityStatSource::NumSlots == AbilitySlot::Num, "Stat sources must cover every ability slot");
+
+namespace
+{
+    template<typename EnumType>
+    void AddAbilityNames(TMap<FString, uint8>& Names)
+    {
+        const UEnum* Enum = StaticEnum<EnumType>();
+        for (uint8 Index = 1; Index < static_cast<uint8>(EnumType::Max); ++Index)
+        {
+            Names.Add(Enum->GetNameStringByValue(Index), Index);
+        }
+    }
+
+    /** Split one CSV line into fields, honouring quoted fields and doubled quotes */
+    void SplitCsvLine(FStringView Line, TArray<FString>& OutFields)
+    {
+        OutFields.Reset();
+        FString Field;
+        bool bQuoted = false;
+        for (int32 Index = 0; Index < Line.Len(); ++Index)
+        {
+            const TCHAR Char = Line[Index];
+            if (bQuoted)
+            {
+                if (Char == TEXT('"'))
+                {
+                    if (Index + 1 < Line.Len() && Line[Index + 1] == TEXT('"'))
+                    {
+                        Field.AppendChar(TEXT('"'));
+                        ++Index;
+                    }
+                    else
+                    {
+                        bQuoted = false;
+                    }
+                }
+                else
+                {
+                    Field.AppendChar(Char);
+                }
+            }
+            else if (Char == TEXT('"'))
+            {
+                bQuoted = true;
+            }
+            else if (Char == TEXT(','))
+            {
+                OutFields.Add(MoveTemp(Field));
+                Field.Reset();
+            }
+            else if (Char != TEXT('\r'))
+            {
+                Field.AppendChar(Char);
+            }
+        }
+        OutFields.Add(MoveTemp(Field));
+    }
+}
+
+// ------------------ Table ------------------
+
+int32 FAbilityDefinitionTable::FindVariant(FName Variant) const
+{
+    const int32* Found = VariantIndices.Find(Variant);
+    return Found ? *Found : INDEX_NONE;
+}
+
+int32 FAbilityDefinitionTable::FindOrAddVariant(FName Variant)
+{
+    if (const int32* Found = VariantIndices.Find(Variant))
+    {
+        return *Found;
+    }
+
+    const int32 Index = VariantNames.Add(Variant);
+    VariantIndices.Add(Variant, Index);
+    Definitions.AddDefaulted(AbilitySlot::Num);
+    StatTables.AddDefaulted();
+    return Index;
+}
+
+const FAbilityDefinition* FAbilityDefinitionTable::Find(int32 Variant, EAbilityGroup Group, uint8 Ability) const
+{
+    if (!VariantNames.IsValidIndex(Variant) || Ability >= AbilitySlot::GroupStride)
+    {
+        return nullptr;
+    }
+
+    const FAbilityDefinition& Definition = Definitions[Variant * AbilitySlot::Num + AbilitySlot::Index(Group, Ability)];
+    return Definition.bDefined ? &Definition : nullptr;
+}
+
+FAbilityDefinition& FAbilityDefinitionTable::Edit(int32 Variant, EAbilityGroup Group, uint8 Ability)
+{
+    check(VariantNames.IsValidIndex(Variant) && Ability < AbilitySlot::GroupStride);
+    return Definitions[Variant * AbilitySlot::Num + AbilitySlot::Index(Group, Ability)];
+}
+
+int32 FAbilityDefinitionTable::GetNumDefined() const
+{
+    int32 Count = 0;
+    for (const FAbilityDefinition& Definition : Definitions)
+    {
+        Count += Definition.bDefined ? 1 : 0;
+    }
+    return Count;
+}
+
+void FAbilityDefinitionTable::Compile()
+{
+    Prerequisites.SetNum(VariantNames.Num());
+    for (int32 Variant = 0; Variant < VariantNames.Num(); ++Variant)
+    {
+        Prerequisites[Variant].Compile(MakeArrayView(Definitions.GetData() + Variant * AbilitySlot::Num, AbilitySlot::Num));
+        StatTables[Variant].Compile();
+    }
+}
+
+const FAbilityPrerequisiteGraph* FAbilityDefinitionTable::GetPrerequisites(int32 Variant) const
+{
+    return Prerequisites.IsValidIndex(Variant) ? &Prerequisites[Variant] : nullptr;
+}
+
+int32 FAbilityDefinitionTable::FindStat(FName Stat) const
+{
+    const int32* Found = StatIndices.Find(Stat);
+    return Found ? *Found : INDEX_NONE;
+}
+
+int32 FAbilityDefinitionTable::FindOrAddStat(FName Stat)
+{
+    if (const int32* Found = StatIndices.Find(Stat))
+    {
+        return *Found;
+    }
+    if (StatNames.Num() >= FAbilityStatTable::MaxStats)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 Index = StatNames.Add(Stat);
+    StatIndices.Add(Stat, Index);
+    return Index;
+}
+
+FAbilityStatTable& FAbilityDefinitionTable::EditStats(int32 Variant)
+{
+    check(StatTables.IsValidIndex(Variant));
+    return StatTables[Variant];
+}
+
+const FAbilityStatTable* FAbilityDefinitionTable::GetStats(int32 Variant) const
+{
+    return StatTables.IsValidIndex(Variant) ? &StatTables[Variant] : nullptr;
+}
+
+uint32 FAbilityDefinitionTable::CompileTagQuery(int32 Variant, const FGameplayTagQuery& Query) const
+{
+    if (!VariantNames.IsValidIndex(Variant) || Query.IsEmpty())
+    {
+        return 0;
+    }
+
+    uint32 Mask = 0;
+    const FAbilityDefinition* VariantDefinitions = &Definitions[Variant * AbilitySlot::Num];
+    for (int32 Slot = 0; Slot < AbilitySlot::Num; ++Slot)
+    {
+        const FAbilityDefinition& Definition = VariantDefinitions[Slot];
+        if (Definition.bDefined && Query.Matches(Definition.Tags))
+        {
+            Mask |= 1u << Slot;
+        }
+    }
+    return Mask;
+}
+
+// ------------------ Importer ------------------
+
+FAbilityDefinitionImporter::FAbilityDefinitionImporter()
+{
+    const UEnum* GroupEnum = StaticEnum<EAbilityGroup>();
+    for (uint8 Index = 0; Index < static_cast<uint8>(EAbilityGroup::Max); ++Index)
+    {
+        GroupNames.Add(GroupEnum->GetNameStringByValue(Index), static_cast<EAbilityGroup>(Index));
+    }
+
+    AddAbilityNames<ECombatAbility>(AbilityNames[static_cast<int32>(EAbilityGroup::Combat)]);
+    AddAbilityNames<ESupportAbility>(AbilityNames[static_cast<int32>(EAbilityGroup::Support)]);
+    AddAbilityNames<EMovementAbility>(AbilityNames[static_cast<int32>(EAbilityGroup::Movement)]);
+    AddAbilityNames<EControlAbility>(AbilityNames[static_cast<int32>(EAbilityGroup::Control)]);
+
+    const UEnum* CategoryEnum = StaticEnum<EAbilityCategory>();
+    for (uint8 Index = 1; Index < static_cast<uint8>(EAbilityCategory::Max); ++Index)
+    {
+        CategoryNames.Add(CategoryEnum->GetNameStringByValue(Index), static_cast<EAbilityCategory>(Index));
+    }
+
+    AddAbilityNames<EMartialAbilityType>(TypeNames[static_cast<int32>(EAbilityCategory::Martial)]);
+    AddAbilityNames<EMagicalAbilityType>(TypeNames[static_cast<int32>(EAbilityCategory::Magical)]);
+    AddAbilityNames<ECraftingAbilityType>(TypeNames[static_cast<int32>(EAbilityCategory::Crafting)]);
+    AddAbilityNames<ESurvivalAbilityType>(TypeNames[static_cast<int32>(EAbilityCategory::Survival)]);
+    AddAbilityNames<EStealthAbilityType>(TypeNames[static_cast<int32>(EAbilityCategory::Stealth)]);
+}
+
+bool FAbilityDefinitionImporter::ImportFile(const FString& Filename, FAbilityDefinitionTable& Table, FString& OutError)
+{
+    const FString Extension = FPaths::GetExtension(Filename);
+    bool bImported;
+    if (Extension.Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+    {
+        bImported = ImportCsv(Filename, Table, OutError);
+    }
+    else if (Extension.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+    {
+        bImported = ImportJson(Filename, Table, OutError);
+    }
+    else
+    {
+        OutError = FString::Printf(TEXT("Unsupported ability definition file '%s'."), *Filename);
+        return false;
+    }
+
+    // One summary per file; the individual rows are logged at Verbose.
+    if (bImported && NumSkipped > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Skipped %d of %d ability definition rows in '%s': unknown group, ability, category or type."), NumSkipped, NumRows + NumSkipped, *Filename);
+    }
+    return bImported;
+}
+
+bool FAbilityDefinitionImporter::ImportCsv(const FString& Filename, FAbilityDefinitionTable& Table, FString& OutError)
+{
+    NumRows = 0;
+    NumSkipped = 0;
+
+    enum EColumn { Variant, Faction, Group, Ability, Category, Type, Cooldown, EnergyCost, Description, Tags, Requires, Stats, Count };
+    static const TCHAR* ColumnNames[Count] = { TEXT("Variant"), TEXT("Faction"), TEXT("Group"), TEXT("Ability"), TEXT("Category"), TEXT("Type"), TEXT("Cooldown"), TEXT("EnergyCost"), TEXT("Description"), TEXT("Tags"), TEXT("Requires"), TEXT("Stats") };
+
+    int32 Columns[Count];
+    for (int32& Column : Columns)
+    {
+        Column = INDEX_NONE;
+    }
+    bool bHeader = true;
+    TArray<FString> Fields;
+    FRow Row;
+
+    auto ProcessRecord = [&](FStringView Record)
+    {
+        SplitCsvLine(Record, Fields);
+        if (bHeader)
+        {
+            for (int32 Column = 0; Column < Count; ++Column)
+            {
+                Columns[Column] = Fields.IndexOfByPredicate([Column](const FString& Field) { return Field.TrimStartAndEnd().Equals(ColumnNames[Column], ESearchCase::IgnoreCase); });
+            }
+            bHeader = false;
+            return;
+        }
+
+        auto Get = [&Fields, &Columns](int32 Column) -> FString*
+        {
+            return Fields.IsValidIndex(Columns[Column]) ? &Fields[Columns[Column]] : nullptr;
+        };
+
+        Row.Reset();
+        if (FString* Value = Get(Variant)) { Row.Variant = MoveTemp(*Value); }
+        if (FString* Value = Get(Faction)) { Row.Faction = MoveTemp(*Value); }
+        if (FString* Value = Get(Group)) { Row.Group = MoveTemp(*Value); }
+        if (FString* Value = Get(Ability)) { Row.Ability = MoveTemp(*Value); }
+        if (FString* Value = Get(Category)) { Row.Category = MoveTemp(*Value); }
+        if (FString* Value = Get(Type)) { Row.Type = MoveTemp(*Value); }
+        if (FString* Value = Get(Description)) { Row.Description = MoveTemp(*Value); }
+        if (FString* Value = Get(Stats)) { Row.Stats = MoveTemp(*Value); }
+        if (FString* Value = Get(Cooldown)) { LexFromString(Row.Cooldown, **Value); }
+        if (FString* Value = Get(EnergyCost)) { LexFromString(Row.EnergyCost, **Value); }
+        if (FString* Value = Get(Tags)) { AddTags(*Value, Row); }
+        if (FString* Value = Get(Requires)) { AddRequirements(*Value, Row); }
+        CommitRow(Row, Table);
+    };
+
+    // A quoted field may span lines: lines are joined until the quotes balance ("" escapes count twice).
+    FString Pending;
+    bool bInQuotes = false;
+    const bool bRead = FFileHelper::LoadFileToStringWithLineVisitor(*Filename, [&](FStringView Line)
+    {
+        if (Line.EndsWith(TEXT('\r')))
+        {
+            Line.LeftChopInline(1);
+        }
+        if (Line.IsEmpty() && !bInQuotes)
+        {
+            return;
+        }
+
+        for (const TCHAR Char : Line)
+        {
+            if (Char == TEXT('"'))
+            {
+                bInQuotes = !bInQuotes;
+            }
+        }
+
+        if (bInQuotes)
+        {
+            Pending.Append(Line);
+            Pending.AppendChar(TEXT('\n'));
+        }
+        else if (!Pending.IsEmpty())
+        {
+            Pending.Append(Line);
+            ProcessRecord(Pending);
+            Pending.Reset();
+        }
+        else
+        {
+            ProcessRecord(Line);
+        }
+    });
+
+    if (!bRead)
+    {
+        OutError = FString::Printf(TEXT("Unable to read '%s'."), *Filename);
+        return false;
+    }
+    if (bInQuotes)
+    {
+        OutError = FString::Printf(TEXT("'%s' ends inside a quoted field."), *Filename);
+        return false;
+    }
+    const bool bSlotColumns = Columns[Group] != INDEX_NONE && Columns[Ability] != INDEX_NONE;
+    const bool bProgressionColumns = Columns[Category] != INDEX_NONE && Columns[Type] != INDEX_NONE;
+    if (bHeader || (!bSlotColumns && !bProgressionColumns))
+    {
+        OutError = FString::Printf(TEXT("'%s' has no Group/Ability or Category/Type header."), *Filename);
+        return false;
+    }
+    return true;
+}
+
+bool FAbilityDefinitionImporter::ImportJson(const FString& Filename, FAbilityDefinitionTable& Table, FString& OutError)
+{
+    NumRows = 0;
+    NumSkipped = 0;
+
+    TUniquePtr<FArchive> File(IFileManager::Get().CreateFileReader(*Filename));
+    if (!File)
+    {
+        OutError = FString::Printf(TEXT("Unable to read '%s'."), *Filename);
+        return false;
+    }
+
+    // Walk tokens instead of building a DOM; rows are the objects of the top-level array.
+    TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::Create(File.Get());
+    EJsonNotation Notation;
+    int32 Depth = 0;
+    FString ArrayField;
+    FRow Row;
+
+    while (Reader->ReadNext(Notation))
+    {
+        switch (Notation)
+        {
+        case EJsonNotation::ArrayStart:
+        case EJsonNotation::ObjectStart:
+            if (++Depth == 2)
+            {
+                Row.Reset();
+            }
+            ArrayField = Depth == 3 && Notation == EJsonNotation::ArrayStart ? Reader->GetIdentifier() : FString();
+            break;
+
+        case EJsonNotation::ArrayEnd:
+        case EJsonNotation::ObjectEnd:
+            if (Depth-- == 2 && Notation == EJsonNotation::ObjectEnd)
+            {
+                CommitRow(Row, Table);
+            }
+            ArrayField.Reset();
+            break;
+
+        case EJsonNotation::String:
+        case EJsonNotation::Number:
+            if (ArrayField == TEXT("Tags"))
+            {
+                AddTags(Reader->GetValueAsString(), Row);
+            }
+            else if (ArrayField == TEXT("Requires"))
+            {
+                AddRequirements(Reader->GetValueAsString(), Row);
+            }
+            else if (ArrayField == TEXT("Stats"))
+            {
+                Row.Stats += Reader->GetValueAsString() + TEXT(";");
+            }
+            else if (Depth == 2)
+            {
+                const FString& Identifier = Reader->GetIdentifier();
+                if (Identifier == TEXT("Variant")) { Row.Variant = Reader->GetValueAsString(); }
+                else if (Identifier == TEXT("Faction")) { Row.Faction = Reader->GetValueAsString(); }
+                else if (Identifier == TEXT("Group")) { Row.Group = Reader->GetValueAsString(); }
+                else if (Identifier == TEXT("Ability")) { Row.Ability = Reader->GetValueAsString(); }
+                else if (Identifier == TEXT("Category")) { Row.Category = Reader->GetValueAsString(); }
+                else if (Identifier == TEXT("Type")) { Row.Type = Reader->GetValueAsString(); }
+                else if (Identifier == TEXT("Description")) { Row.Description = Reader->GetValueAsString(); }
+                else if (Identifier == TEXT("Cooldown")) { Row.Cooldown = static_cast<float>(Reader->GetValueAsNumber()); }
+                else if (Identifier == TEXT("EnergyCost")) { Row.EnergyCost = static_cast<float>(Reader->GetValueAsNumber()); }
+                else if (Identifier == TEXT("Tags")) { AddTags(Reader->GetValueAsString(), Row); }
+                else if (Identifier == TEXT("Requires")) { AddRequirements(Reader->GetValueAsString(), Row); }
+                else if (Identifier == TEXT("Stats")) { Row.Stats = Reader->GetValueAsString(); }
+            }
+            break;
+
+        case EJsonNotation::Error:
+            OutError = FString::Printf(TEXT("'%s': %s"), *Filename, *Reader->GetErrorMessage());
+            return false;
+
+        default:
+            break;
+        }
+    }
+
+    if (Notation == EJsonNotation::Error || Depth != 0)
+    {
+        OutError = FString::Printf(TEXT("'%s': %s"), *Filename, *Reader->GetErrorMessage());
+        return false;
+    }
+    return true;
+}
+
+void FAbilityDefinitionImporter::FRow::Reset()
+{
+    Variant.Reset();
+    Faction.Reset();
+    Group.Reset();
+    Ability.Reset();
+    Category.Reset();
+    Type.Reset();
+    Description.Reset();
+    Stats.Reset();
+    Tags.Reset();
+    Requirements.Reset();
+    Cooldown = 0.f;
+    EnergyCost = 0.f;
+}
+
+void FAbilityDefinitionImporter::CommitRow(const FRow& Row, FAbilityDefinitionTable& Table)
+{
+    const FString VariantName = Row.Variant.IsEmpty() ? TEXT("Default") : Row.Variant;
+    const FName Variant = Row.Faction.IsEmpty() ? FName(*VariantName) : FName(*(VariantName + TEXT(".") + Row.Faction));
+
+    // Progression rows only carry stat terms.
+    if (!Row.Category.IsEmpty())
+    {
+        int32 Source;
+        if (!ResolveProgressionSource(Row.Category, Row.Type, Source))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("Skipping ability definition %s.%s: unknown category or type."), *Row.Category, *Row.Type);
+            ++NumSkipped;
+            return;
+        }
+
+        AddStatTerms(Row.Stats, Source, Table.FindOrAddVariant(Variant), Table);
+        ++NumRows;
+        return;
+    }
+
+    EAbilityGroup Group;
+    uint8 Ability;
+    if (!ResolveSlot(Row.Group, Row.Ability, Group, Ability))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Skipping ability definition %s.%s: unknown group or ability."), *Row.Group, *Row.Ability);
+        ++NumSkipped;
+        return;
+    }
+
+    const int32 VariantIndex = Table.FindOrAddVariant(Variant);
+    FAbilityDefinition& Definition = Table.Edit(VariantIndex, Group, Ability);
+    Definition.Cooldown = Row.Cooldown;
+    Definition.EnergyCost = Row.EnergyCost;
+    Definition.Description = Row.Description;
+    Definition.Tags = Row.Tags;
+    Definition.Requirements = Row.Requirements;
+    Definition.bDefined = true;
+    AddStatTerms(Row.Stats, AbilityStatSource::Slot(AbilitySlot::Index(Group, Ability)), VariantIndex, Table);
+    ++NumRows;
+}
+
+void FAbilityDefinitionImporter::AddTags(const FString& Names, FRow& Row) const
+{
+    TArray<FString> Parts;
+    Names.ParseIntoArray(Parts, TEXT(";"));
+    for (const FString& Part : Parts)
+    {
+        const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(*Part.TrimStartAndEnd()), false);
+        if (Tag.IsValid())
+        {
+            Row.Tags.AddTag(Tag);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Skipping unknown ability tag '%s'."), *Part);
+        }
+    }
+}
+
+void FAbilityDefinitionImporter::AddRequirements(const FString& Names, FRow& Row) const
+{
+    TArray<FString> Parts;
+    Names.ParseIntoArray(Parts, TEXT(";"));
+    for (const FString& Part : Parts)
+    {
+        FString Name = Part.TrimStartAndEnd();
+        FString LevelText;
+        int32 Level = 1;
+        if (Name.Split(TEXT(":"), &Name, &LevelText))
+        {
+            LexFromString(Level, *LevelText);
+        }
+
+        FString GroupName;
+        FString AbilityName;
+        EAbilityGroup Group;
+        uint8 Ability;
+        if (!Name.Split(TEXT("."), &GroupName, &AbilityName) || !ResolveSlot(GroupName, AbilityName, Group, Ability))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Skipping unknown ability prerequisite '%s'."), *Part);
+            continue;
+        }
+
+        FAbilityRequirement& Requirement = Row.Requirements.AddDefaulted_GetRef();
+        Requirement.Slot = static_cast<uint8>(AbilitySlot::Index(Group, Ability));
+        Requirement.Level = static_cast<uint8>(FMath::Clamp(Level, 1, 255));
+    }
+}
+
+void FAbilityDefinitionImporter::AddStatTerms(const FString& Terms, int32 Source, int32 Variant, FAbilityDefinitionTable& Table) const
+{
+    TArray<FString> Parts;
+    Terms.ParseIntoArray(Parts, TEXT(";"));
+    for (const FString& Part : Parts)
+    {
+        FString Name;
+        FString PerPointText;
+        float PerPoint = 0.f;
+        if (!Part.Split(TEXT(":"), &Name, &PerPointText) || !LexTryParseString(PerPoint, *PerPointText.TrimStartAndEnd()))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Skipping malformed stat term '%s'."), *Part);
+            continue;
+        }
+
+        const int32 Stat = Table.FindOrAddStat(FName(*Name.TrimStartAndEnd()));
+        if (Stat == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Skipping stat term '%s': more than %d derived stats."), *Part, FAbilityStatTable::MaxStats);
+            continue;
+        }
+        Table.EditStats(Variant).AddTerm(Stat, Source, PerPoint);
+    }
+}
+
+bool FAbilityDefinitionImporter::ResolveProgressionSource(const FString& Category, const FString& Type, int32& OutSource) const
+{
+    const EAbilityCategory* FoundCategory = CategoryNames.Find(Category.TrimStartAndEnd());
+    if (!FoundCategory)
+    {
+        return false;
+    }
+
+    const uint8* FoundType = TypeNames[static_cast<int32>(*FoundCategory)].Find(Type.TrimStartAndEnd());
+    if (!FoundType)
+    {
+        return false;
+    }
+
+    OutSource = AbilityStatSource::Progression(*FoundCategory, *FoundType);
+    return true;
+}
+
+bool FAbilityDefinitionImporter::ResolveSlot(const FString& Group, const FString& Ability, EAbilityGroup& OutGroup, uint8& OutAbility) const
+{
+    const EAbilityGroup* FoundGroup = GroupNames.Find(Group.TrimStartAndEnd());
+    if (!FoundGroup)
+    {
+        return false;
+    }
+
+    const uint8* FoundAbility = AbilityNames[static_cast<int32>(*FoundGroup)].Find(Ability.TrimStartAndEnd());
+    if (!FoundAbility)
+    {
+        return false;
+    }
+
+    OutGroup = *FoundGroup;
+    OutAbility = *FoundAbility;
+    return true;
+}
+
+// ------------------ Registry ------------------
+
+std::atomic<uint32> FAbilityDefinitionRegistry::Version{ 0 };
+
+FAbilityDefinitionRegistry::FTablePtr& FAbilityDefinitionRegistry::CurrentTable()
+{
+    static FTablePtr Table;
+    return Table;
+}
+
+const FAbilityDefinitionRegistry::FTablePtr& FAbilityDefinitionRegistry::GetTable()
+{
+    check(IsInGameThread());
+    return CurrentTable();
+}
+
+uint32 FAbilityDefinitionRegistry::GetVersion()
+{
+    return Version.load(std::memory_order_acquire);
+}
+
+void FAbilityDefinitionRegistry::Publish(FTablePtr NewTable)
+{
+    check(IsInGameThread());
+    CurrentTable() = MoveTemp(NewTable);
+    Version.fetch_add(1, std::memory_order_release);
+}
+
+void FAbilityDefinitionRegistry::ReloadAsync(TArray<FString> Files)
+{
+    Async(EAsyncExecution::ThreadPool, [Files = MoveTemp(Files)]()
+    {
+        TSharedPtr<FAbilityDefinitionTable, ESPMode::ThreadSafe> Table = MakeShared<FAbilityDefinitionTable, ESPMode::ThreadSafe>();
+        FAbilityDefinitionImporter Importer;
+        const double Start = FPlatformTime::Seconds();
+        for (const FString& Filename : Files)
+        {
+            FString Error;
+            if (!Importer.ImportFile(Filename, *Table, Error))
+            {
+                UE_LOG(LogTemp, Error, TEXT("Ability definition reload failed, keeping the current table: %s"), *Error);
+                return;
+            }
+        }
+        Table->Compile();
+        UE_LOG(LogTemp, Display, TEXT("Ability definitions reloaded: %d variants in %.2f ms."), Table->GetNumVariants(), (FPlatformTime::Seconds() - Start) * 1000.0);
+
+        AsyncTask(ENamedThreads::GameThread, [Table]()
+        {
+            Publish(Table);
+        });
+    });
+}
+
+// ------------------ Tag Query ------------------
+
+FAbilityTagQuery::FAbilityTagQuery(const FGameplayTagQuery& InQuery)
+    : Query(InQuery)
+{
+}
+
+uint32 FAbilityTagQuery::GetMask(int32 Variant) const
+{
+    // Compile every variant at once, and only after a reload published a new table.
+    const uint32 Version = FAbilityDefinitionRegistry::GetVersion();
+    if (CompiledVersion != Version)
+    {
+        VariantMasks.Reset();
+        if (const FAbilityDefinitionRegistry::FTablePtr& Table = FAbilityDefinitionRegistry::GetTable())
+        {
+            VariantMasks.SetNumUninitialized(Table->GetNumVariants());
+            for (int32 Index = 0; Index < VariantMasks.Num(); ++Index)
+            {
+                VariantMasks[Index] = Table->CompileTagQuery(Index, Query);
+            }
+        }
+        CompiledVersion = Version;
+    }
+
+    return VariantMasks.IsValidIndex(Variant) ? VariantMasks[Variant] : 0;
+}
+
+static FAutoConsoleCommand GAbilityReloadDefinitionsCommand(
+    TEXT("Ability.ReloadDefinitions"),
+    TEXT("Reload ability definition tables from the given .csv/.json files without restarting."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        if (Args.IsEmpty())
+        {
+            UE_LOG(LogTemp, Error, TEXT("Usage: Ability.ReloadDefinitions <File> [<File> ...]"));
+            return;
+        }
+        FAbilityDefinitionRegistry::ReloadAsync(Args);
+    }));
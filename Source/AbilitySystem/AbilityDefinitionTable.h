@@ -0,0 +1,257 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilityType.h"
+#include "AbilityPrerequisiteGraph.h"
+#include "AbilityDerivedStats.h"
+#include "GameplayTagContainer.h"
+#include <atomic>
+
+/**
+ * Tuning of one ability slot for one variant.
+ */
+struct FAbilityDefinition
+{
+    float Cooldown = 0.f;
+
+    float EnergyCost = 0.f;
+
+    FString Description;
+
+    /** Classification tags, e.g. Ability.Mobility, Ability.CC, Ability.Elemental.Fire */
+    FGameplayTagContainer Tags;
+
+    /** Slots that must be unlocked (at a minimum level) before this one */
+    TArray<FAbilityRequirement> Requirements;
+
+    /** True if a row defined this slot */
+    bool bDefined = false;
+};
+
+/**
+ * Flat, enum-indexed ability definitions for every variant (e.g. "Default", "Orc.Horde").
+ * Lookups are a single array index: Variant * AbilitySlot::Num + slot.
+ */
+class YOURGAME_API FAbilityDefinitionTable
+{
+public:
+    /** Index of a variant, or INDEX_NONE if the table does not contain it */
+    int32 FindVariant(FName Variant) const;
+
+    /** Index of a variant, adding an empty one if needed */
+    int32 FindOrAddVariant(FName Variant);
+
+    /** Definition of an ability slot, or nullptr if the variant or slot is undefined */
+    const FAbilityDefinition* Find(int32 Variant, EAbilityGroup Group, uint8 Ability) const;
+
+    /** Mutable definition of an ability slot; the variant must exist */
+    FAbilityDefinition& Edit(int32 Variant, EAbilityGroup Group, uint8 Ability);
+
+    int32 GetNumVariants() const { return VariantNames.Num(); }
+
+    FName GetVariantName(int32 Variant) const { return VariantNames[Variant]; }
+
+    /** Number of defined slots across all variants */
+    int32 GetNumDefined() const;
+
+    /** Slot bits (see AbilitySlot) of the variant's defined abilities whose tags match the query */
+    uint32 CompileTagQuery(int32 Variant, const FGameplayTagQuery& Query) const;
+
+    /** Build derived data, such as the prerequisite graphs, once every row is imported */
+    void Compile();
+
+    /** Compiled prerequisites of a variant, or nullptr if the variant is unknown or the table was not compiled */
+    const FAbilityPrerequisiteGraph* GetPrerequisites(int32 Variant) const;
+
+    /** Index of a derived stat shared by every variant, or INDEX_NONE */
+    int32 FindStat(FName Stat) const;
+
+    /** Index of a derived stat, adding it if needed; INDEX_NONE once FAbilityStatTable::MaxStats are in use */
+    int32 FindOrAddStat(FName Stat);
+
+    int32 GetNumStats() const { return StatNames.Num(); }
+
+    FName GetStatName(int32 Stat) const { return StatNames[Stat]; }
+
+    /** Mutable stat terms of a variant; the variant must exist */
+    FAbilityStatTable& EditStats(int32 Variant);
+
+    /** Stat terms of a variant, or nullptr if the variant is unknown. Compiled by Compile */
+    const FAbilityStatTable* GetStats(int32 Variant) const;
+
+private:
+
+    /** Variant names in index order */
+    TArray<FName> VariantNames;
+
+    /** Variant name to index */
+    TMap<FName, int32> VariantIndices;
+
+    /** AbilitySlot::Num definitions per variant */
+    TArray<FAbilityDefinition> Definitions;
+
+    /** Compiled prerequisite graph per variant */
+    TArray<FAbilityPrerequisiteGraph> Prerequisites;
+
+    /** Derived stat names in index order, and name to index */
+    TArray<FName> StatNames;
+    TMap<FName, int32> StatIndices;
+
+    /** Stat terms per variant */
+    TArray<FAbilityStatTable> StatTables;
+};
+
+/**
+ * Streaming importer for ability definition tables.
+ *
+ * CSV: a header row naming the columns, then one row per definition.
+ * JSON: an array of row objects using the same field names.
+ *
+ * Fields: Group (EAbilityGroup name), Ability (enum name within the group), and optionally
+ * Variant, Faction, Cooldown, EnergyCost, Description, Tags, Requires, Stats. Variant and Faction
+ * combine into the variant key "Variant.Faction"; a missing variant means "Default". Tags is a ';'
+ * separated list of gameplay tag names and Requires a ';' separated list of Group.Ability[:Level]
+ * prerequisites, e.g. "Combat.Charge:3" (JSON arrays of names are accepted too). Unknown tags and
+ * prerequisites are skipped. Call FAbilityDefinitionTable::Compile after the last file.
+ *
+ * Stats is a ';' separated list of Stat:PerPoint derived stat terms, e.g. "Damage:0.05;MoveSpeed:0.01",
+ * added per level of the ability. Rows with Category (EAbilityCategory name) and Type instead of
+ * Group and Ability only contribute Stats terms, per active point of that progression module.
+ *
+ * Rows are parsed and written straight into the flat table while the file is read, so memory
+ * stays proportional to the table rather than to the file.
+ */
+class YOURGAME_API FAbilityDefinitionImporter
+{
+public:
+    FAbilityDefinitionImporter();
+
+    /** Import a .csv or .json file into the table and log a summary of skipped rows. Returns false and fills OutError on failure */
+    bool ImportFile(const FString& Filename, FAbilityDefinitionTable& Table, FString& OutError);
+
+    /** Import a CSV file line by line; quoted fields may span lines */
+    bool ImportCsv(const FString& Filename, FAbilityDefinitionTable& Table, FString& OutError);
+
+    /** Import a JSON file token by token */
+    bool ImportJson(const FString& Filename, FAbilityDefinitionTable& Table, FString& OutError);
+
+    /** Rows imported by the last call */
+    int32 GetNumRows() const { return NumRows; }
+
+    /** Rows skipped by the last call because their group or ability was unknown */
+    int32 GetNumSkipped() const { return NumSkipped; }
+
+private:
+
+    /** One row as read from the file */
+    struct FRow
+    {
+        FString Variant;
+        FString Faction;
+        FString Group;
+        FString Ability;
+        FString Category;
+        FString Type;
+        FString Description;
+        FString Stats;
+        FGameplayTagContainer Tags;
+        TArray<FAbilityRequirement> Requirements;
+        float Cooldown = 0.f;
+        float EnergyCost = 0.f;
+
+        void Reset();
+    };
+
+    /** Write a parsed row into the table */
+    void CommitRow(const FRow& Row, FAbilityDefinitionTable& Table);
+
+    /** Add the tags of a ';' separated list to a row */
+    void AddTags(const FString& Names, FRow& Row) const;
+
+    /** Add the prerequisites of a ';' separated Group.Ability[:Level] list to a row */
+    void AddRequirements(const FString& Names, FRow& Row) const;
+
+    /** Add the Stat:PerPoint terms of a ';' separated list to a variant's stat table */
+    void AddStatTerms(const FString& Terms, int32 Source, int32 Variant, FAbilityDefinitionTable& Table) const;
+
+    /** Resolve a progression category and type name to a stat source */
+    bool ResolveProgressionSource(const FString& Category, const FString& Type, int32& OutSource) const;
+
+    /** Resolve group and ability names to a group and enum value */
+    bool ResolveSlot(const FString& Group, const FString& Ability, EAbilityGroup& OutGroup, uint8& OutAbility) const;
+
+    /** Enum names of every group, resolved once */
+    TMap<FString, EAbilityGroup> GroupNames;
+    TMap<FString, uint8> AbilityNames[static_cast<int32>(EAbilityGroup::Max)];
+
+    /** Enum names of every progression category, resolved once */
+    TMap<FString, EAbilityCategory> CategoryNames;
+    TMap<FString, uint8> TypeNames[static_cast<int32>(EAbilityCategory::Max)];
+
+    int32 NumRows = 0;
+    int32 NumSkipped = 0;
+};
+
+/**
+ * Process-wide, versioned ability definition table.
+ *
+ * The current table is published as a shared pointer and a version number. Readers (game thread)
+ * compare the version with the one they cached and re-resolve their variant only when it changed,
+ * so a reload costs nothing per component and nothing is re-instanced. Reloads import on a worker
+ * thread and swap the pointer on the game thread; tables still referenced by in-flight reads stay
+ * alive until released.
+ *
+ * Console: Ability.ReloadDefinitions <File> [<File> ...]
+ */
+class YOURGAME_API FAbilityDefinitionRegistry
+{
+public:
+    using FTablePtr = TSharedPtr<const FAbilityDefinitionTable, ESPMode::ThreadSafe>;
+
+    /** Current table, or null if none was published. Game thread only */
+    static const FTablePtr& GetTable();
+
+    /** Incremented on every publish; 0 means no table was ever published */
+    static uint32 GetVersion();
+
+    /** Swap in a new table. Game thread only */
+    static void Publish(FTablePtr NewTable);
+
+    /** Import the files on a worker thread and publish the result on the game thread */
+    static void ReloadAsync(TArray<FString> Files);
+
+private:
+    static FTablePtr& CurrentTable();
+    static std::atomic<uint32> Version;
+};
+
+/**
+ * Gameplay tag query compiled to ability slot bitmasks.
+ *
+ * Matching tag containers per ability per query is too slow for AI, so the query is evaluated
+ * once per variant against the definition tags and cached as a slot mask. Testing a component is
+ * then a single AND with its unlocked mask. The masks are recompiled lazily after a definition
+ * reload. Game thread only; build the query once and keep it around.
+ */
+class YOURGAME_API FAbilityTagQuery
+{
+public:
+    FAbilityTagQuery() = default;
+
+    explicit FAbilityTagQuery(const FGameplayTagQuery& InQuery);
+
+    /** Slot bits of the variant whose definition tags match, or 0 if the variant is unknown */
+    uint32 GetMask(int32 Variant) const;
+
+    const FGameplayTagQuery& GetQuery() const { return Query; }
+
+private:
+
+    FGameplayTagQuery Query;
+
+    /** Registry version VariantMasks were compiled against */
+    mutable uint32 CompiledVersion = 0;
+
+    /** Compiled mask per definition table variant */
+    mutable TArray<uint32> VariantMasks;
+};
@@ -0,0 +1,414 @@
+#include "AbilityEffectSubsystem.h"
+#include "GameFramework/DamageType.h"
+#include "Kismet/GameplayStatics.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+    /** Append the indices i for which Times[i] <= Now, comparing four lanes at a time */
+    void SelectDue(const TArray<float>& Times, float Now, TArray<int32>& OutSelected)
+    {
+        OutSelected.Reset();
+
+        const int32 Num = Times.Num();
+        const float* Data = Times.GetData();
+        const VectorRegister4Float NowVector = VectorSetFloat1(Now);
+
+        int32 Index = 0;
+        for (; Index + 4 <= Num; Index += 4)
+        {
+            int32 Mask = VectorMaskBits(VectorCompareLE(VectorLoad(Data + Index), NowVector));
+            while (Mask != 0)
+            {
+                OutSelected.Add(Index + FMath::CountTrailingZeros(static_cast<uint32>(Mask)));
+                Mask &= Mask - 1;
+            }
+        }
+        for (; Index < Num; ++Index)
+        {
+            if (Data[Index] <= Now)
+            {
+                OutSelected.Add(Index);
+            }
+        }
+    }
+}
+
+// ------------------ Effects ------------------
+
+bool UAbilityEffectSubsystem::ApplyEffect(AActor* Target, EControlAbility Type, float Magnitude, float Duration, float TickInterval)
+{
+    return ApplyEffectBatch(MakeArrayView(&Target, 1), Type, Magnitude, Duration, TickInterval) > 0;
+}
+
+int32 UAbilityEffectSubsystem::ApplyEffectToTargets(const TArray<AActor*>& InTargets, EControlAbility Type, float Magnitude, float Duration, float TickInterval)
+{
+    return ApplyEffectBatch(InTargets, Type, Magnitude, Duration, TickInterval);
+}
+
+int32 UAbilityEffectSubsystem::ApplyEffectBatch(TConstArrayView<AActor*> InTargets, EControlAbility Type, float Magnitude, float Duration, float TickInterval)
+{
+    if (Type == EControlAbility::None || Type == EControlAbility::Max || Duration <= 0.f || InTargets.IsEmpty())
+    {
+        return 0;
+    }
+
+    RebaseTimes(GetWorld()->GetTimeSeconds());
+    const float Now = ToLocalTime(GetWorld()->GetTimeSeconds());
+    const float Interval = Type == EControlAbility::Burn ? FMath::Max(TickInterval, MinTickInterval) : 0.f;
+    const uint8 Bit = EffectBit(Type);
+
+    // Grow every array once for the whole batch.
+    const int32 Capacity = Types.Num() + InTargets.Num();
+    TargetSlots.Reserve(Capacity);
+    Types.Reserve(Capacity);
+    Magnitudes.Reserve(Capacity);
+    ExpireTimes.Reserve(Capacity);
+    NextTickTimes.Reserve(Capacity);
+    TickIntervals.Reserve(Capacity);
+
+    Affected.Reset();
+    int32 NumImmune = 0;
+    for (AActor* Target : InTargets)
+    {
+        if (!Target)
+        {
+            continue;
+        }
+
+        // Immune targets always hold a slot, so only new, non-immune targets are added here.
+        const int32 Slot = FindOrAddTarget(Target);
+        if ((Targets[Slot].ImmunityMask & Bit) != 0)
+        {
+            ++NumImmune;
+            continue;
+        }
+
+        WriteEffect(Slot, Type, Magnitude, Now, Duration, Interval);
+        Affected.Add(Target);
+    }
+
+    const int32 NumAffected = Affected.Num();
+    if (NumAffected > 0 || NumImmune > 0)
+    {
+        OnEffectApplied.Broadcast(Type, Affected, NumImmune);
+    }
+    return NumAffected;
+}
+
+void UAbilityEffectSubsystem::SetEffectImmunity(AActor* Target, EControlAbility Type, bool bImmune)
+{
+    if (Type == EControlAbility::None || Type == EControlAbility::Max)
+    {
+        return;
+    }
+
+    const uint8 Mask = GetImmunityMask(Target);
+    SetImmunityMask(Target, bImmune ? (Mask | EffectBit(Type)) : (Mask & ~EffectBit(Type)));
+}
+
+void UAbilityEffectSubsystem::SetImmunityMask(AActor* Target, uint8 Mask)
+{
+    if (!Target)
+    {
+        return;
+    }
+
+    const int32 Slot = Mask != 0 ? FindOrAddTarget(Target) : FindTarget(Target);
+    if (Slot != INDEX_NONE)
+    {
+        Targets[Slot].ImmunityMask = Mask;
+        ReleaseTargetIfUnused(Slot);
+    }
+}
+
+void UAbilityEffectSubsystem::ClearEffects()
+{
+    TimeEpoch = 0.0;
+    PruneCursor = 0;
+    TargetSlots.Reset();
+    Types.Reset();
+    Magnitudes.Reset();
+    ExpireTimes.Reset();
+    NextTickTimes.Reset();
+    TickIntervals.Reset();
+    Targets.Reset();
+    FreeTargets.Reset();
+    TargetLookup.Reset();
+    DamagedTargets.Reset();
+}
+
+void UAbilityEffectSubsystem::RemoveEffect(AActor* Target, EControlAbility Type)
+{
+    const int32 Index = FindEffect(Target, Type);
+    if (Index != INDEX_NONE)
+    {
+        RemoveEffectAt(Index);
+    }
+}
+
+bool UAbilityEffectSubsystem::HasEffect(const AActor* Target, EControlAbility Type) const
+{
+    return FindEffect(Target, Type) != INDEX_NONE;
+}
+
+float UAbilityEffectSubsystem::GetEffectMagnitude(const AActor* Target, EControlAbility Type) const
+{
+    const int32 Index = FindEffect(Target, Type);
+    return Index != INDEX_NONE ? Magnitudes[Index] : 0.f;
+}
+
+bool UAbilityEffectSubsystem::IsIncapacitated(const AActor* Target) const
+{
+    return (GetEffectMask(Target) & (EffectBit(EControlAbility::Stun) | EffectBit(EControlAbility::Freeze))) != 0;
+}
+
+uint8 UAbilityEffectSubsystem::GetImmunityMask(const AActor* Target) const
+{
+    const int32 Slot = FindTarget(Target);
+    return Slot != INDEX_NONE ? Targets[Slot].ImmunityMask : 0;
+}
+
+uint8 UAbilityEffectSubsystem::GetEffectMask(const AActor* Target) const
+{
+    const int32 Slot = FindTarget(Target);
+    if (Slot == INDEX_NONE)
+    {
+        return 0;
+    }
+
+    uint8 Mask = 0;
+    for (int32 Type = 0; Type < NumEffectTypes; ++Type)
+    {
+        Mask |= Targets[Slot].Effects[Type] != INDEX_NONE ? static_cast<uint8>(1u << Type) : 0;
+    }
+    return Mask;
+}
+
+// ------------------ Tick ------------------
+
+void UAbilityEffectSubsystem::Tick(float DeltaTime)
+{
+    if (Types.Num() > 0)
+    {
+        ProcessEffects(GetWorld()->GetTimeSeconds());
+    }
+    PruneStaleTargets(TargetsPrunedPerTick);
+}
+
+TStatId UAbilityEffectSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAbilityEffectSubsystem, STATGROUP_Tickables);
+}
+
+void UAbilityEffectSubsystem::ProcessEffects(double WorldTime)
+{
+    RebaseTimes(WorldTime);
+    const float Now = ToLocalTime(WorldTime);
+
+    // Damage over time. Only Burn has a finite next tick; catch up on every tick due before expiry.
+    SelectDue(NextTickTimes, Now, Selected);
+    for (const int32 Index : Selected)
+    {
+        float& NextTick = NextTickTimes[Index];
+        const float End = FMath::Min(Now, ExpireTimes[Index]);
+        int32 Ticks = 0;
+        if (NextTick <= End)
+        {
+            Ticks = FMath::FloorToInt((End - NextTick) / TickIntervals[Index]) + 1;
+            NextTick += Ticks * TickIntervals[Index];
+        }
+
+        if (Ticks > 0)
+        {
+            FTarget& Target = Targets[TargetSlots[Index]];
+            if (Target.PendingDamage == 0.f)
+            {
+                DamagedTargets.Add(TargetSlots[Index]);
+            }
+            Target.PendingDamage += Magnitudes[Index] * Ticks;
+        }
+    }
+    FlushDamage();
+
+    // Expiry. Remove from the back so swapped-in effects were already checked.
+    SelectDue(ExpireTimes, Now, Selected);
+    for (int32 Position = Selected.Num() - 1; Position >= 0; --Position)
+    {
+        RemoveEffectAt(Selected[Position]);
+    }
+}
+
+void UAbilityEffectSubsystem::RebaseTimes(double WorldTime)
+{
+    // Whole seconds are exact in float, so shifting by them keeps every phase.
+    const double Elapsed = WorldTime - TimeEpoch;
+    if (Elapsed < RebaseThreshold)
+    {
+        return;
+    }
+
+    const float Shift = static_cast<float>(FMath::FloorToDouble(Elapsed));
+    for (float& ExpireTime : ExpireTimes)
+    {
+        ExpireTime -= Shift;
+    }
+    for (float& NextTick : NextTickTimes)
+    {
+        if (NextTick != MAX_flt)
+        {
+            NextTick -= Shift;
+        }
+    }
+    TimeEpoch += Shift;
+}
+
+void UAbilityEffectSubsystem::PruneStaleTargets(int32 MaxSlots)
+{
+    for (int32 Count = FMath::Min(MaxSlots, Targets.Num()); Count > 0; --Count)
+    {
+        PruneCursor = PruneCursor + 1 < Targets.Num() ? PruneCursor + 1 : 0;
+        FTarget& Target = Targets[PruneCursor];
+        if (Target.Key == FObjectKey() || Target.Actor.IsValid())
+        {
+            continue;
+        }
+
+        // The actor is gone: drop its immunities and effects, which releases the slot.
+        Target.ImmunityMask = 0;
+        bool bHasEffects = false;
+        for (int32 Type = 0; Type < NumEffectTypes; ++Type)
+        {
+            if (Targets[PruneCursor].Effects[Type] != INDEX_NONE)
+            {
+                RemoveEffectAt(Targets[PruneCursor].Effects[Type]);
+                bHasEffects = true;
+            }
+        }
+        if (!bHasEffects)
+        {
+            ReleaseTargetIfUnused(PruneCursor);
+        }
+    }
+}
+
+// ------------------ Storage ------------------
+
+int32 UAbilityEffectSubsystem::FindOrAddTarget(AActor* Target)
+{
+    if (const int32* Found = TargetLookup.Find(FObjectKey(Target)))
+    {
+        return *Found;
+    }
+
+    const int32 Slot = FreeTargets.Num() > 0 ? FreeTargets.Pop(EAllowShrinking::No) : Targets.AddDefaulted();
+    FTarget& Entry = Targets[Slot];
+    Entry.Actor = Target;
+    Entry.Key = FObjectKey(Target);
+    Entry.PendingDamage = 0.f;
+    Entry.ImmunityMask = 0;
+    for (int32& Effect : Entry.Effects)
+    {
+        Effect = INDEX_NONE;
+    }
+    TargetLookup.Add(FObjectKey(Target), Slot);
+    return Slot;
+}
+
+int32 UAbilityEffectSubsystem::FindTarget(const AActor* Target) const
+{
+    const int32* Found = Target ? TargetLookup.Find(FObjectKey(Target)) : nullptr;
+    return Found ? *Found : INDEX_NONE;
+}
+
+int32 UAbilityEffectSubsystem::FindEffect(const AActor* Target, EControlAbility Type) const
+{
+    const int32 Slot = FindTarget(Target);
+    if (Slot == INDEX_NONE || Type == EControlAbility::None || Type == EControlAbility::Max)
+    {
+        return INDEX_NONE;
+    }
+    return Targets[Slot].Effects[static_cast<int32>(Type) - 1];
+}
+
+void UAbilityEffectSubsystem::WriteEffect(int32 TargetSlot, EControlAbility Type, float Magnitude, float Now, float Duration, float TickInterval)
+{
+    const float ExpireTime = Now + Duration;
+    int32& Effect = Targets[TargetSlot].Effects[static_cast<int32>(Type) - 1];
+    if (Effect != INDEX_NONE)
+    {
+        // Refresh: keep the later expiry and the stronger magnitude; the tick phase is preserved.
+        Magnitudes[Effect] = FMath::Max(Magnitudes[Effect], Magnitude);
+        ExpireTimes[Effect] = FMath::Max(ExpireTimes[Effect], ExpireTime);
+        return;
+    }
+
+    Effect = Types.Add(Type);
+    TargetSlots.Add(TargetSlot);
+    Magnitudes.Add(Magnitude);
+    ExpireTimes.Add(ExpireTime);
+    NextTickTimes.Add(TickInterval > 0.f ? Now + TickInterval : MAX_flt);
+    TickIntervals.Add(TickInterval);
+}
+
+void UAbilityEffectSubsystem::RemoveEffectAt(int32 Index)
+{
+    const int32 Slot = TargetSlots[Index];
+    FTarget& Target = Targets[Slot];
+    Target.Effects[static_cast<int32>(Types[Index]) - 1] = INDEX_NONE;
+
+    // Point the target of the effect moving into Index at its new position.
+    const int32 Last = Types.Num() - 1;
+    if (Index != Last)
+    {
+        Targets[TargetSlots[Last]].Effects[static_cast<int32>(Types[Last]) - 1] = Index;
+    }
+
+    TargetSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Types.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Magnitudes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    ExpireTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    NextTickTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    TickIntervals.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+    ReleaseTargetIfUnused(Slot);
+}
+
+void UAbilityEffectSubsystem::ReleaseTargetIfUnused(int32 Slot)
+{
+    FTarget& Target = Targets[Slot];
+    if (Target.ImmunityMask != 0)
+    {
+        return;
+    }
+    for (const int32 Effect : Target.Effects)
+    {
+        if (Effect != INDEX_NONE)
+        {
+            return;
+        }
+    }
+
+    TargetLookup.Remove(Target.Key);
+    Target.Actor.Reset();
+    Target.Key = FObjectKey();
+    FreeTargets.Add(Slot);
+}
+
+void UAbilityEffectSubsystem::FlushDamage()
+{
+    // Damage handlers may apply or remove effects, so nothing is held by reference across the call.
+    for (int32 Position = 0; Position < DamagedTargets.Num(); ++Position)
+    {
+        FTarget& Target = Targets[DamagedTargets[Position]];
+        AActor* Actor = Target.Actor.Get();
+        const float Damage = Target.PendingDamage;
+        Target.PendingDamage = 0.f;
+
+        if (Actor)
+        {
+            UGameplayStatics::ApplyDamage(Actor, Damage, nullptr, nullptr, UDamageType::StaticClass());
+        }
+    }
+    DamagedTargets.Reset();
+}
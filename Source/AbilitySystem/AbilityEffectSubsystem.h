@@ -0,0 +1,184 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "AbilityType.h"
+#include "AbilityEffectSubsystem.generated.h"
+
+/** Fired once per application call with every target the effect landed on */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnControlEffectApplied, EControlAbility, Type, const TArray<AActor*>&, Targets, int32, NumImmune);
+
+/**
+ * Status effect engine for control abilities (Stun, Freeze, Burn, Slow).
+ *
+ * Active effects live in parallel arrays (target, type, magnitude, expiry, next tick, tick interval)
+ * rather than per-actor objects, so one AoE freeze on hundreds of NPCs is a handful of appends.
+ * Every frame, damage-over-time ticks and expiry are found by comparing the time arrays four lanes
+ * at a time; only the effects that hit are touched afterwards. Damage is summed per target and
+ * applied once per target per frame.
+ *
+ * A target holds at most one effect per type: reapplying refreshes the duration and keeps the
+ * stronger magnitude. Targets can be immune to types through a per-target bitmask. Times are world
+ * seconds.
+ *
+ * Area effects go through ApplyEffectToTargets: one pass filters immunities, writes the effects
+ * and broadcasts a single OnEffectApplied for the whole batch.
+ */
+UCLASS()
+class YOURGAME_API UAbilityEffectSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ------------------ Effects ------------------
+
+    /**
+     * Apply or refresh a control effect on a target unless it is immune; returns true if it landed.
+     * Magnitude is the slow fraction for Slow and the damage per tick for Burn; TickInterval is only used by Burn.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Control")
+    bool ApplyEffect(AActor* Target, EControlAbility Type, float Magnitude, float Duration, float TickInterval = 1.f);
+
+    /** Apply a control effect to every non-immune target in one pass; returns the number of targets affected */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Control")
+    int32 ApplyEffectToTargets(const TArray<AActor*>& InTargets, EControlAbility Type, float Magnitude, float Duration, float TickInterval = 1.f);
+
+    /** C++ form of ApplyEffectToTargets for callers holding targets in any contiguous container */
+    int32 ApplyEffectBatch(TConstArrayView<AActor*> InTargets, EControlAbility Type, float Magnitude, float Duration, float TickInterval = 1.f);
+
+    /** Make a target immune, or no longer immune, to a control effect */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Control")
+    void SetEffectImmunity(AActor* Target, EControlAbility Type, bool bImmune);
+
+    /** Replace a target's immunities with a mask of EffectBit values */
+    void SetImmunityMask(AActor* Target, uint8 Mask);
+
+    /** Remove every effect and immunity */
+    void ClearEffects();
+
+    /** Remove a control effect from a target */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Control")
+    void RemoveEffect(AActor* Target, EControlAbility Type);
+
+    /** Check if a target is under a control effect */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Control")
+    bool HasEffect(const AActor* Target, EControlAbility Type) const;
+
+    /** Magnitude of a control effect on a target, or 0 if it is not active */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Control")
+    float GetEffectMagnitude(const AActor* Target, EControlAbility Type) const;
+
+    /** Check if a target can act: neither stunned nor frozen */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Control")
+    bool IsIncapacitated(const AActor* Target) const;
+
+    /** Bit per active effect type on a target, see EffectBit */
+    uint8 GetEffectMask(const AActor* Target) const;
+
+    /** Immunities of a target as a mask of EffectBit values */
+    uint8 GetImmunityMask(const AActor* Target) const;
+
+    /** Number of active effects */
+    int32 GetNumEffects() const { return Types.Num(); }
+
+    /** Mask bit of an effect type */
+    static constexpr uint8 EffectBit(EControlAbility Type) { return static_cast<uint8>(1u << (static_cast<uint8>(Type) - 1)); }
+
+    // ------------------ Tick ------------------
+
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override;
+
+    /** Advance effects to the given world time; Tick calls it with the current time */
+    void ProcessEffects(double WorldTime);
+
+    /** Broadcast once per application call */
+    UPROPERTY(BlueprintAssignable, Category = "Ability|Control")
+    FOnControlEffectApplied OnEffectApplied;
+
+protected:
+
+    /** Number of effect types, excluding None */
+    static constexpr int32 NumEffectTypes = static_cast<int32>(EControlAbility::Max) - 1;
+
+    /** Shortest Burn tick interval, one frame at 60 Hz */
+    static constexpr float MinTickInterval = 1.f / 60.f;
+
+    /** Stored times are rebased once they run this many seconds past the epoch, keeping float precision */
+    static constexpr double RebaseThreshold = 1024.0;
+
+    /** Target slots checked for destroyed actors per tick */
+    static constexpr int32 TargetsPrunedPerTick = 32;
+
+    /** Per-target bookkeeping: which effect index holds each type, and immunities */
+    struct FTarget
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FObjectKey Key;
+        int32 Effects[NumEffectTypes];
+        float PendingDamage = 0.f;
+        uint8 ImmunityMask = 0;
+    };
+
+    /** Slot of a target, adding one if needed */
+    int32 FindOrAddTarget(AActor* Target);
+
+    /** Slot of a target, or INDEX_NONE */
+    int32 FindTarget(const AActor* Target) const;
+
+    /** Effect index of a type on a target, or INDEX_NONE */
+    int32 FindEffect(const AActor* Target, EControlAbility Type) const;
+
+    /** Swap-remove one effect from every array and release its target slot once empty */
+    void RemoveEffectAt(int32 Index);
+
+    /** Release a target slot that holds neither effects nor immunities */
+    void ReleaseTargetIfUnused(int32 Slot);
+
+    /** Write one effect, appending it or refreshing the existing one of the same type */
+    void WriteEffect(int32 TargetSlot, EControlAbility Type, float Magnitude, float Now, float Duration, float TickInterval);
+
+    /** Apply the damage summed per target since the last flush */
+    void FlushDamage();
+
+    /** Move the time epoch forward once world time has run RebaseThreshold past it */
+    void RebaseTimes(double WorldTime);
+
+    /** Effect time relative to the epoch */
+    float ToLocalTime(double WorldTime) const { return static_cast<float>(WorldTime - TimeEpoch); }
+
+    /** Release up to MaxSlots target slots whose actor was destroyed, continuing from the last call */
+    void PruneStaleTargets(int32 MaxSlots);
+
+    // ------------------ Effect storage (SoA) ------------------
+
+    /** World time the stored expire and tick times are relative to */
+    double TimeEpoch = 0.0;
+
+    TArray<int32> TargetSlots;
+    TArray<EControlAbility> Types;
+    TArray<float> Magnitudes;
+    TArray<float> ExpireTimes;
+    TArray<float> NextTickTimes;
+    TArray<float> TickIntervals;
+
+    // ------------------ Target storage ------------------
+
+    TArray<FTarget> Targets;
+    TArray<int32> FreeTargets;
+    TMap<FObjectKey, int32> TargetLookup;
+
+    /** Last target slot checked by PruneStaleTargets */
+    int32 PruneCursor = 0;
+
+    /** Targets that took damage this frame */
+    TArray<int32> DamagedTargets;
+
+    /** Scratch list of effect indices selected by a batch compare */
+    TArray<int32> Selected;
+
+    /** Scratch list of targets a batch landed on, passed to OnEffectApplied */
+    TArray<AActor*> Affected;
+};
@@ -0,0 +1,161 @@
+#include "AbilityIndexSubsystem.h"
+#include "AbilityComponent.h"
+
+void UAbilityIndexSubsystem::Deinitialize()
+{
+    for (UAbilityComponent* Component : Components)
+    {
+        if (Component)
+        {
+            Component->AbilityIndexHandle = INDEX_NONE;
+        }
+    }
+    Components.Reset();
+    Masks.Reset();
+    FreeHandles.Reset();
+    for (int32 Slot = 0; Slot < AbilitySlot::Num; ++Slot)
+    {
+        Members[Slot].Reset();
+        MemberHandles[Slot].Reset();
+        Positions[Slot].Reset();
+    }
+
+    Super::Deinitialize();
+}
+
+// ------------------ Queries ------------------
+
+TConstArrayView<UAbilityComponent*> UAbilityIndexSubsystem::GetComponentsWithAbility(EAbilityGroup Group, uint8 Ability) const
+{
+    if (Ability >= AbilitySlot::GroupStride)
+    {
+        return TConstArrayView<UAbilityComponent*>();
+    }
+    return Members[AbilitySlot::Index(Group, Ability)];
+}
+
+TArray<AActor*> UAbilityIndexSubsystem::GetActorsWithCombatAbility(ECombatAbility Ability) const
+{
+    return GetActors(EAbilityGroup::Combat, static_cast<uint8>(Ability));
+}
+
+TArray<AActor*> UAbilityIndexSubsystem::GetActorsWithSupportAbility(ESupportAbility Ability) const
+{
+    return GetActors(EAbilityGroup::Support, static_cast<uint8>(Ability));
+}
+
+TArray<AActor*> UAbilityIndexSubsystem::GetActorsWithMovementAbility(EMovementAbility Ability) const
+{
+    return GetActors(EAbilityGroup::Movement, static_cast<uint8>(Ability));
+}
+
+TArray<AActor*> UAbilityIndexSubsystem::GetActorsWithControlAbility(EControlAbility Ability) const
+{
+    return GetActors(EAbilityGroup::Control, static_cast<uint8>(Ability));
+}
+
+TArray<AActor*> UAbilityIndexSubsystem::GetActors(EAbilityGroup Group, uint8 Ability) const
+{
+    TConstArrayView<UAbilityComponent*> Found = GetComponentsWithAbility(Group, Ability);
+
+    TArray<AActor*> Actors;
+    Actors.Reserve(Found.Num());
+    for (UAbilityComponent* Component : Found)
+    {
+        Actors.Add(Component->GetOwner());
+    }
+    return Actors;
+}
+
+// ------------------ Registration ------------------
+
+void UAbilityIndexSubsystem::Register(UAbilityComponent* Component, uint32 UnlockedMask)
+{
+    check(Component && Component->AbilityIndexHandle == INDEX_NONE);
+
+    int32 Handle;
+    if (FreeHandles.Num() > 0)
+    {
+        Handle = FreeHandles.Pop(EAllowShrinking::No);
+        Components[Handle] = Component;
+        Masks[Handle] = 0;
+    }
+    else
+    {
+        Handle = Components.Add(Component);
+        Masks.Add(0);
+        for (TArray<int32>& SlotPositions : Positions)
+        {
+            SlotPositions.Add(INDEX_NONE);
+        }
+    }
+
+    Component->AbilityIndexHandle = Handle;
+    UpdateUnlockedMask(Component, UnlockedMask);
+}
+
+void UAbilityIndexSubsystem::Unregister(UAbilityComponent* Component)
+{
+    const int32 Handle = Component ? Component->AbilityIndexHandle : INDEX_NONE;
+    if (!Components.IsValidIndex(Handle) || Components[Handle] != Component)
+    {
+        return;
+    }
+
+    UpdateUnlockedMask(Component, 0);
+    Components[Handle] = nullptr;
+    FreeHandles.Add(Handle);
+    Component->AbilityIndexHandle = INDEX_NONE;
+}
+
+void UAbilityIndexSubsystem::UpdateUnlockedMask(UAbilityComponent* Component, uint32 NewMask)
+{
+    const int32 Handle = Component->AbilityIndexHandle;
+    if (!Components.IsValidIndex(Handle) || Components[Handle] != Component)
+    {
+        return;
+    }
+
+    // Visit only the flipped bits.
+    uint32 Changed = Masks[Handle] ^ NewMask;
+    Masks[Handle] = NewMask;
+    while (Changed != 0)
+    {
+        const int32 Slot = FMath::CountTrailingZeros(Changed);
+        Changed &= Changed - 1;
+
+        if (NewMask & (1u << Slot))
+        {
+            AddMember(Slot, Handle);
+        }
+        else
+        {
+            RemoveMember(Slot, Handle);
+        }
+    }
+}
+
+void UAbilityIndexSubsystem::AddMember(int32 Slot, int32 Handle)
+{
+    Positions[Slot][Handle] = Members[Slot].Add(Components[Handle].Get());
+    MemberHandles[Slot].Add(Handle);
+}
+
+void UAbilityIndexSubsystem::RemoveMember(int32 Slot, int32 Handle)
+{
+    const int32 Position = Positions[Slot][Handle];
+    if (Position == INDEX_NONE)
+    {
+        return;
+    }
+
+    // Swap the last member into the hole.
+    const int32 LastHandle = MemberHandles[Slot].Last();
+    Members[Slot].RemoveAtSwap(Position, 1, EAllowShrinking::No);
+    MemberHandles[Slot].RemoveAtSwap(Position, 1, EAllowShrinking::No);
+    if (LastHandle != Handle)
+    {
+        Positions[Slot][LastHandle] = Position;
+    }
+    Positions[Slot][Handle] = INDEX_NONE;
+}
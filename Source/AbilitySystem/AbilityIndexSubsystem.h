@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AbilityType.h"
+#include "AbilityIndexSubsystem.generated.h"
+
+class UAbilityComponent;
+
+/**
+ * World-level reverse index from ability slot to the components that have it unlocked.
+ *
+ * Every slot keeps a sparse set of registered components: a dense member array plus each
+ * component's position in it, so membership changes are O(1) swaps and "who has X unlocked"
+ * returns the dense array directly, in O(result). Components feed it their unlocked mask
+ * whenever it changes (unlock, replication, respec), and only the flipped bits are touched.
+ *
+ * Registered components are referenced through Components, so the raw pointers in the member
+ * arrays stay valid. Components leave the index on EndPlay or OnUnregister, and the index
+ * releases any component still registered when the world goes away.
+ */
+UCLASS()
+class YOURGAME_API UAbilityIndexSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    // ------------------ Queries ------------------
+
+    /** Components with the given ability slot unlocked, in no particular order */
+    TConstArrayView<UAbilityComponent*> GetComponentsWithAbility(EAbilityGroup Group, uint8 Ability) const;
+
+    /** Actors with a combat ability unlocked */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Combat")
+    TArray<AActor*> GetActorsWithCombatAbility(ECombatAbility Ability) const;
+
+    /** Actors with a support ability unlocked */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Support")
+    TArray<AActor*> GetActorsWithSupportAbility(ESupportAbility Ability) const;
+
+    /** Actors with a movement ability unlocked */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Movement")
+    TArray<AActor*> GetActorsWithMovementAbility(EMovementAbility Ability) const;
+
+    /** Actors with a control ability unlocked */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Control")
+    TArray<AActor*> GetActorsWithControlAbility(EControlAbility Ability) const;
+
+    /** Number of registered components */
+    int32 GetNumRegistered() const { return Components.Num() - FreeHandles.Num(); }
+
+    // ------------------ Registration ------------------
+
+    /** Start tracking a component with its current unlocked mask */
+    void Register(UAbilityComponent* Component, uint32 UnlockedMask);
+
+    /** Stop tracking a component */
+    void Unregister(UAbilityComponent* Component);
+
+    /** Apply a component's new unlocked mask; only slots whose bit flipped are updated */
+    void UpdateUnlockedMask(UAbilityComponent* Component, uint32 NewMask);
+
+private:
+
+    /** Add a handle to a slot's member set */
+    void AddMember(int32 Slot, int32 Handle);
+
+    /** Remove a handle from a slot's member set */
+    void RemoveMember(int32 Slot, int32 Handle);
+
+    /** Collect owning actors of a slot's members */
+    TArray<AActor*> GetActors(EAbilityGroup Group, uint8 Ability) const;
+
+    /** Registered components by handle; null for free handles. Keeps the members below alive */
+    UPROPERTY()
+    TArray<TObjectPtr<UAbilityComponent>> Components;
+
+    /** Unlocked mask per handle as last seen by the index */
+    TArray<uint32> Masks;
+
+    /** Handles available for reuse */
+    TArray<int32> FreeHandles;
+
+    /** Dense member components per slot */
+    TArray<UAbilityComponent*> Members[AbilitySlot::Num];
+
+    /** Dense member handles per slot, parallel to Members */
+    TArray<int32> MemberHandles[AbilitySlot::Num];
+
+    /** Position of each handle in a slot's dense arrays, INDEX_NONE if absent */
+    TArray<int32> Positions[AbilitySlot::Num];
+};
@@ -0,0 +1,170 @@
+#include "AbilityPrerequisiteGraph.h"
+#include "AbilityDefinitionTable.h"
+
+void FAbilityPrerequisiteGraph::Compile(TConstArrayView<FAbilityDefinition> Definitions)
+{
+    check(Definitions.Num() == AbilitySlot::Num);
+
+    // Direct edges: prerequisite -> dependent.
+    uint32 Incoming[AbilitySlot::Num] = {};
+    for (int32 Slot = 0; Slot < AbilitySlot::Num; ++Slot)
+    {
+        for (const FAbilityRequirement& Requirement : Definitions[Slot].Requirements)
+        {
+            if (Requirement.Slot != Slot)
+            {
+                Incoming[Slot] |= 1u << Requirement.Slot;
+            }
+        }
+    }
+
+    // Transitive prerequisites, iterated to a fixed point (at most AbilitySlot::Num passes).
+    uint32 Ancestors[AbilitySlot::Num];
+    FMemory::Memcpy(Ancestors, Incoming, sizeof(Incoming));
+    for (bool bChanged = true; bChanged; )
+    {
+        bChanged = false;
+        for (int32 Slot = 0; Slot < AbilitySlot::Num; ++Slot)
+        {
+            uint32 Reachable = Ancestors[Slot];
+            for (uint32 Bits = Ancestors[Slot]; Bits != 0; Bits &= Bits - 1)
+            {
+                Reachable |= Ancestors[FMath::CountTrailingZeros(Bits)];
+            }
+            bChanged |= Reachable != Ancestors[Slot];
+            Ancestors[Slot] = Reachable;
+        }
+    }
+
+    // A slot that reaches itself sits on a cycle. Only the edges inside its strongly connected
+    // component are dropped (prerequisite and dependent reach each other); requirements of slots
+    // downstream of the cycle, and cycle members' requirements outside it, are kept.
+    uint32 Dropped[AbilitySlot::Num] = {};
+    for (int32 Slot = 0; Slot < AbilitySlot::Num; ++Slot)
+    {
+        if ((Ancestors[Slot] & (1u << Slot)) == 0)
+        {
+            continue;
+        }
+
+        UE_LOG(LogTemp, Error, TEXT("Ability slot %d is part of a prerequisite cycle; its requirements within the cycle are ignored."), Slot);
+        for (uint32 Bits = Incoming[Slot]; Bits != 0; Bits &= Bits - 1)
+        {
+            const int32 Prerequisite = FMath::CountTrailingZeros(Bits);
+            if (Ancestors[Prerequisite] & (1u << Slot))
+            {
+                Dropped[Slot] |= 1u << Prerequisite;
+            }
+        }
+        Incoming[Slot] &= ~Dropped[Slot];
+    }
+
+    // Kahn's algorithm over the bitmasks; the pruned graph is acyclic, so every slot is placed.
+    TopologicalOrder.Reset();
+    uint32 Remaining = static_cast<uint32>((uint64(1) << AbilitySlot::Num) - 1);
+    uint32 Placed = 0;
+    while (Remaining != 0)
+    {
+        const uint32 Pending = Remaining;
+        for (uint32 Bits = Pending; Bits != 0; Bits &= Bits - 1)
+        {
+            const int32 Slot = FMath::CountTrailingZeros(Bits);
+            if ((Incoming[Slot] & ~Placed) == 0)
+            {
+                TopologicalOrder.Add(static_cast<uint8>(Slot));
+                Placed |= 1u << Slot;
+                Remaining &= ~(1u << Slot);
+            }
+        }
+        check(Remaining != Pending);
+    }
+
+    // Per-slot requirement masks, grouped by level.
+    bHasRequirements = false;
+    for (int32 Slot = 0; Slot < AbilitySlot::Num; ++Slot)
+    {
+        RequiredMasks[Slot] = 0;
+        DependentMasks[Slot] = 0;
+        LevelRequirements[Slot].Reset();
+    }
+    for (int32 Slot = 0; Slot < AbilitySlot::Num; ++Slot)
+    {
+        for (const FAbilityRequirement& Requirement : Definitions[Slot].Requirements)
+        {
+            if (Requirement.Slot == Slot || (Dropped[Slot] & (1u << Requirement.Slot)))
+            {
+                continue;
+            }
+
+            const uint32 Bit = 1u << Requirement.Slot;
+            RequiredMasks[Slot] |= Bit;
+            DependentMasks[Requirement.Slot] |= 1u << Slot;
+            bHasRequirements = true;
+
+            if (Requirement.Level > 1)
+            {
+                FLevelRequirement* Group = LevelRequirements[Slot].FindByPredicate([&Requirement](const FLevelRequirement& Item) { return Item.Level == Requirement.Level; });
+                if (!Group)
+                {
+                    Group = &LevelRequirements[Slot].AddDefaulted_GetRef();
+                    Group->Level = Requirement.Level;
+                }
+                Group->Mask |= Bit;
+            }
+        }
+    }
+
+    // Transitive dependents, filled from the end of the order so dependents are complete first.
+    for (int32 Index = TopologicalOrder.Num() - 1; Index >= 0; --Index)
+    {
+        const int32 Slot = TopologicalOrder[Index];
+        uint32 Reachable = DependentMasks[Slot];
+        for (uint32 Bits = DependentMasks[Slot]; Bits != 0; Bits &= Bits - 1)
+        {
+            Reachable |= ReachableMasks[FMath::CountTrailingZeros(Bits)];
+        }
+        ReachableMasks[Slot] = Reachable;
+    }
+}
+
+bool FAbilityPrerequisiteGraph::CanUnlock(int32 Slot, uint32 UnlockedMask, TConstArrayView<uint8> Levels) const
+{
+    const uint32 Required = RequiredMasks[Slot];
+    if ((UnlockedMask & Required) != Required)
+    {
+        return false;
+    }
+
+    for (const FLevelRequirement& Requirement : LevelRequirements[Slot])
+    {
+        if ((GetLevelMask(Levels, Requirement.Level) & Requirement.Mask) != Requirement.Mask)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32 FAbilityPrerequisiteGraph::GetNewlyAvailable(int32 Slot, uint32 UnlockedMask, TConstArrayView<uint8> Levels) const
+{
+    uint32 Available = 0;
+    for (uint32 Bits = DependentMasks[Slot] & ~UnlockedMask; Bits != 0; Bits &= Bits - 1)
+    {
+        const int32 Dependent = FMath::CountTrailingZeros(Bits);
+        if (CanUnlock(Dependent, UnlockedMask, Levels))
+        {
+            Available |= 1u << Dependent;
+        }
+    }
+    return Available;
+}
+
+uint32 FAbilityPrerequisiteGraph::GetLevelMask(TConstArrayView<uint8> Levels, uint8 MinLevel)
+{
+    uint32 Mask = 0;
+    for (int32 Slot = 0; Slot < Levels.Num() && Slot < AbilitySlot::Num; ++Slot)
+    {
+        Mask |= (Levels[Slot] >= MinLevel ? 1u : 0u) << Slot;
+    }
+    return Mask;
+}
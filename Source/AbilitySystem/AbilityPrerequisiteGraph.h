@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilityType.h"
+
+struct FAbilityDefinition;
+
+/** One prerequisite: a flat ability slot that must be unlocked, at least at Level */
+struct FAbilityRequirement
+{
+    uint8 Slot = 0;
+    uint8 Level = 1;
+};
+
+/**
+ * Ability prerequisites of one definition variant, compiled to slot bitmasks.
+ *
+ * Requirements come from the definition rows (e.g. Overdrive requires Combat.Charge:3). Compile
+ * orders the slots topologically, drops only the requirements between members of the same cycle
+ * (strongly connected component), and stores per slot:
+ *   - the mask of slots that must be unlocked,
+ *   - masks of slots that must reach a higher level, grouped by level,
+ *   - the direct and transitive dependents, i.e. what an unlock can make available.
+ * "Can unlock X" is then a mask compare per distinct level threshold (usually one).
+ */
+class YOURGAME_API FAbilityPrerequisiteGraph
+{
+public:
+    /** Compile from AbilitySlot::Num definitions; undefined slots have no requirements */
+    void Compile(TConstArrayView<FAbilityDefinition> Definitions);
+
+    /** True if every prerequisite of the slot is met by the unlocked mask and per-slot levels */
+    bool CanUnlock(int32 Slot, uint32 UnlockedMask, TConstArrayView<uint8> Levels) const;
+
+    /** Locked slots that depend on Slot and whose prerequisites are now all met */
+    uint32 GetNewlyAvailable(int32 Slot, uint32 UnlockedMask, TConstArrayView<uint8> Levels) const;
+
+    /** Slots that must be unlocked before Slot */
+    uint32 GetRequiredMask(int32 Slot) const { return RequiredMasks[Slot]; }
+
+    /** Slots that directly list Slot as a prerequisite */
+    uint32 GetDependentMask(int32 Slot) const { return DependentMasks[Slot]; }
+
+    /** Slots that depend on Slot directly or through other prerequisites */
+    uint32 GetReachableMask(int32 Slot) const { return ReachableMasks[Slot]; }
+
+    /** Slots in prerequisite order: every slot comes after the slots it requires */
+    TConstArrayView<uint8> GetTopologicalOrder() const { return TopologicalOrder; }
+
+    /** True if any slot has a prerequisite */
+    bool HasRequirements() const { return bHasRequirements; }
+
+private:
+
+    /** Slots that must reach at least Level */
+    struct FLevelRequirement
+    {
+        uint8 Level = 0;
+        uint32 Mask = 0;
+    };
+
+    /** Mask of slots whose level is at least MinLevel */
+    static uint32 GetLevelMask(TConstArrayView<uint8> Levels, uint8 MinLevel);
+
+    uint32 RequiredMasks[AbilitySlot::Num] = {};
+    uint32 DependentMasks[AbilitySlot::Num] = {};
+    uint32 ReachableMasks[AbilitySlot::Num] = {};
+    TArray<FLevelRequirement, TInlineAllocator<1>> LevelRequirements[AbilitySlot::Num];
+    TArray<uint8> TopologicalOrder;
+    bool bHasRequirements = false;
+};
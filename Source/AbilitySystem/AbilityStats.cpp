@@ -0,0 +1,25 @@
+#include "AbilityStats.h"
+
+DEFINE_STAT(STAT_Ability_Lookup);
+DEFINE_STAT(STAT_Ability_Unlock);
+DEFINE_STAT(STAT_Ability_Upgrade);
+DEFINE_STAT(STAT_Ability_Validate);
+DEFINE_STAT(STAT_Ability_Activate);
+DEFINE_STAT(STAT_Ability_Serialize);
+DEFINE_STAT(STAT_Ability_ProgressionLookup);
+DEFINE_STAT(STAT_Ability_ProgressionChange);
+DEFINE_STAT(STAT_Ability_Allocate);
+
+DEFINE_STAT(STAT_Ability_LookupCalls);
+DEFINE_STAT(STAT_Ability_UnlockCalls);
+DEFINE_STAT(STAT_Ability_UpgradeCalls);
+DEFINE_STAT(STAT_Ability_ValidateCalls);
+DEFINE_STAT(STAT_Ability_ActivateCalls);
+DEFINE_STAT(STAT_Ability_SerializeCalls);
+DEFINE_STAT(STAT_Ability_ProgressionLookupCalls);
+DEFINE_STAT(STAT_Ability_ProgressionChangeCalls);
+DEFINE_STAT(STAT_Ability_AllocateCalls);
+
+UE_TRACE_CHANNEL_DEFINE(AbilityChannel);
+
+UE_TRACE_EVENT_DEFINE(Ability, Operation);
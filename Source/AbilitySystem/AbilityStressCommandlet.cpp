@@ -0,0 +1,256 @@
+#include "AbilityStressCommandlet.h"
+#include "AbilityBenchmarkComponent.h"
+#include "AbilityBenchmarkUtils.h"
+#include "AbilityComponent.h"
+#include "AbilityEffectSubsystem.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace AbilityStress
+{
+    /**
+     * Number of events due this frame for a per-actor-per-second rate. The fractional remainder is
+     * carried over, so low rates still fire at the right average frequency.
+     */
+    int32 ConsumeEvents(double& InOutBudget, int32 NumActors, float Rate, float DeltaSeconds)
+    {
+        InOutBudget += static_cast<double>(NumActors) * Rate * DeltaSeconds;
+        const int32 Count = static_cast<int32>(InOutBudget);
+        InOutBudget -= Count;
+        return Count;
+    }
+
+    /** Value at a percentile of sorted samples */
+    double Percentile(const TArray<double>& Sorted, double Percent)
+    {
+        if (Sorted.IsEmpty())
+        {
+            return 0.0;
+        }
+        const int32 Index = FMath::Clamp(FMath::CeilToInt(Percent / 100.0 * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+        return Sorted[Index];
+    }
+}
+
+UAbilityStressCommandlet::UAbilityStressCommandlet()
+{
+    IsClient = false;
+    IsServer = true;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UAbilityStressCommandlet::Main(const FString& Params)
+{
+    using namespace AbilityBenchmark;
+    using namespace AbilityStress;
+
+    int32 NumActors = 10000;
+    int32 NumFrames = 900;
+    float FrameRate = 30.f;
+    int32 Seed = 1;
+    float UnlockRate = 0.01f;
+    float UpgradeRate = 0.01f;
+    float AllocationRate = 0.01f;
+    float ActivationRate = 0.2f;
+    FParse::Value(*Params, TEXT("Actors="), NumActors);
+    FParse::Value(*Params, TEXT("Frames="), NumFrames);
+    FParse::Value(*Params, TEXT("FrameRate="), FrameRate);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("UnlockRate="), UnlockRate);
+    FParse::Value(*Params, TEXT("UpgradeRate="), UpgradeRate);
+    FParse::Value(*Params, TEXT("AllocationRate="), AllocationRate);
+    FParse::Value(*Params, TEXT("ActivationRate="), ActivationRate);
+    NumActors = FMath::Max(NumActors, 1);
+    NumFrames = FMath::Max(NumFrames, 1);
+    const float DeltaSeconds = 1.f / FMath::Max(FrameRate, 1.f);
+
+    // A game world that has begun play, so spawned actors and registered components begin play too.
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    World->InitializeActorsForPlay(FURL());
+    World->GetWorldSettings()->NotifyBeginPlay();
+    UAbilityEffectSubsystem* Effects = World->GetSubsystem<UAbilityEffectSubsystem>();
+
+    TArray<AActor*> Actors;
+    TArray<UAbilityComponent*> Components;
+    Actors.Reserve(NumActors);
+    Components.Reserve(NumActors);
+
+    const double SpawnStart = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumActors; ++Index)
+    {
+        AActor* Actor = World->SpawnActor<AActor>();
+        UAbilityComponent* Component = NewObject<UAbilityBenchmarkComponent>(Actor);
+        Actor->AddInstanceComponent(Component);
+        Component->RegisterComponent();
+
+        Actors.Add(Actor);
+        Components.Add(Component);
+    }
+    const double SpawnSeconds = FPlatformTime::Seconds() - SpawnStart;
+    UE_LOG(LogTemp, Display, TEXT("AbilityStress: spawned %d actors in %.2f s, running %d frames at %.0f Hz."), NumActors, SpawnSeconds, NumFrames, FrameRate);
+
+    FRandomStream Random(Seed);
+    double UnlockBudget = 0.0;
+    double UpgradeBudget = 0.0;
+    double AllocationBudget = 0.0;
+    double ActivationBudget = 0.0;
+    int64 NumEvents = 0;
+
+    TArray<double> FrameTimes;
+    TArray<double> TrafficTimes;
+    FrameTimes.Reserve(NumFrames);
+    TrafficTimes.Reserve(NumFrames);
+    TArray<FAbilityAllocationDelta> Allocation;
+    Allocation.SetNum(1);
+
+    auto RandomComponent = [&]() -> UAbilityComponent&
+    {
+        return *Components[Random.RandRange(0, NumActors - 1)];
+    };
+    auto RandomGroup = [&]()
+    {
+        return static_cast<EAbilityGroup>(Random.RandRange(0, static_cast<int32>(EAbilityGroup::Max) - 1));
+    };
+
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        const uint64 FrameStart = FPlatformTime::Cycles64();
+
+        for (int32 Count = ConsumeEvents(UnlockBudget, NumActors, UnlockRate, DeltaSeconds); Count > 0; --Count, ++NumEvents)
+        {
+            UAbilityComponent& Component = RandomComponent();
+            const EAbilityGroup Group = RandomGroup();
+            const uint8 Ability = static_cast<uint8>(Random.RandRange(1, NumAbilities(Group)));
+            switch (Group)
+            {
+            case EAbilityGroup::Combat:   Component.UnlockCombatAbility(static_cast<ECombatAbility>(Ability)); break;
+            case EAbilityGroup::Support:  Component.UnlockSupportAbility(static_cast<ESupportAbility>(Ability)); break;
+            case EAbilityGroup::Movement: Component.UnlockMovementAbility(static_cast<EMovementAbility>(Ability)); break;
+            case EAbilityGroup::Control:  Component.UnlockControlAbility(static_cast<EControlAbility>(Ability)); break;
+            default: break;
+            }
+        }
+
+        for (int32 Count = ConsumeEvents(UpgradeBudget, NumActors, UpgradeRate, DeltaSeconds); Count > 0; --Count, ++NumEvents)
+        {
+            UAbilityComponent& Component = RandomComponent();
+            const EAbilityGroup Group = RandomGroup();
+            const uint8 Ability = static_cast<uint8>(Random.RandRange(1, NumAbilities(Group)));
+            switch (Group)
+            {
+            case EAbilityGroup::Combat:   Component.UpgradeCombatAbility(static_cast<ECombatAbility>(Ability)); break;
+            case EAbilityGroup::Support:  Component.UpgradeSupportAbility(static_cast<ESupportAbility>(Ability)); break;
+            case EAbilityGroup::Movement: Component.UpgradeMovementAbility(static_cast<EMovementAbility>(Ability)); break;
+            case EAbilityGroup::Control:  Component.UpgradeControlAbility(static_cast<EControlAbility>(Ability)); break;
+            default: break;
+            }
+        }
+
+        for (int32 Count = ConsumeEvents(AllocationBudget, NumActors, AllocationRate, DeltaSeconds); Count > 0; --Count, ++NumEvents)
+        {
+            // Only deltas the progression accepts, so the run measures applied changes rather than rejections.
+            UAbilityComponent& Component = RandomComponent();
+            FAbilityAllocationDelta& Delta = Allocation[0];
+            if (RandomValidAllocation(Component.GetProgression(), Random, Delta))
+            {
+                Component.AllocateAbilityPoints(Allocation);
+                Component.IncreaseProgressionAbility(Delta.Category, Delta.Type);
+            }
+        }
+
+        for (int32 Count = ConsumeEvents(ActivationBudget, NumActors, ActivationRate, DeltaSeconds); Count > 0; --Count, ++NumEvents)
+        {
+            // Only unlocked abilities can be activated.
+            UAbilityComponent& Component = RandomComponent();
+            const int32 Slot = RandomUnlockedSlot(Component.GetUnlockedMask(), Random);
+            if (Slot == INDEX_NONE)
+            {
+                continue;
+            }
+            const EAbilityGroup Group = static_cast<EAbilityGroup>(Slot / AbilitySlot::GroupStride);
+            const uint8 Ability = static_cast<uint8>(Slot % AbilitySlot::GroupStride);
+            Component.StartAbilityCooldown(Group, Ability);
+            if (Group == EAbilityGroup::Control && Effects)
+            {
+                Effects->ApplyEffect(Actors[Random.RandRange(0, NumActors - 1)], static_cast<EControlAbility>(Ability), 1.f, 3.f);
+            }
+        }
+
+        const uint64 TrafficEnd = FPlatformTime::Cycles64();
+        World->Tick(LEVELTICK_All, DeltaSeconds);
+        const uint64 FrameEnd = FPlatformTime::Cycles64();
+
+        TrafficTimes.Add(FPlatformTime::ToMilliseconds64(TrafficEnd - FrameStart));
+        FrameTimes.Add(FPlatformTime::ToMilliseconds64(FrameEnd - FrameStart));
+    }
+
+    double TotalFrameMs = 0.0;
+    for (double FrameTime : FrameTimes)
+    {
+        TotalFrameMs += FrameTime;
+    }
+    double TotalTrafficMs = 0.0;
+    for (double TrafficTime : TrafficTimes)
+    {
+        TotalTrafficMs += TrafficTime;
+    }
+    FrameTimes.Sort();
+    TrafficTimes.Sort();
+
+    FAbilityMemoryFootprint Memory;
+    for (const UAbilityComponent* Component : Components)
+    {
+        FAbilityMemoryFootprint Footprint;
+        Component->GetMemoryFootprint(Footprint);
+        Memory += Footprint;
+    }
+
+    AddResult(TEXT("Actors"), NumActors, TEXT("count"));
+    AddResult(TEXT("SpawnTimePerActor"), SpawnSeconds * 1000000.0 / NumActors, TEXT("us"));
+    AddResult(TEXT("EventsPerFrame"), static_cast<double>(NumEvents) / NumFrames, TEXT("count"));
+    AddResult(TEXT("FrameTimeMean"), TotalFrameMs / NumFrames, TEXT("ms"));
+    AddResult(TEXT("FrameTimeP50"), Percentile(FrameTimes, 50.0), TEXT("ms"));
+    AddResult(TEXT("FrameTimeP90"), Percentile(FrameTimes, 90.0), TEXT("ms"));
+    AddResult(TEXT("FrameTimeP99"), Percentile(FrameTimes, 99.0), TEXT("ms"));
+    AddResult(TEXT("FrameTimeP999"), Percentile(FrameTimes, 99.9), TEXT("ms"));
+    AddResult(TEXT("FrameTimeMax"), FrameTimes.Last(), TEXT("ms"));
+    AddResult(TEXT("TrafficTimeMean"), TotalTrafficMs / NumFrames, TEXT("ms"));
+    AddResult(TEXT("TrafficTimeP99"), Percentile(TrafficTimes, 99.0), TEXT("ms"));
+    AddResult(TEXT("AbilityMemory"), static_cast<double>(Memory.GetTotal()), TEXT("B"));
+    AddResult(TEXT("AbilityMemoryPerActor"), static_cast<double>(Memory.GetTotal()) / NumActors, TEXT("B"));
+
+    World->DestroyWorld(false);
+
+    TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetArrayField(TEXT("results"), Results);
+
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Report, Writer);
+    UE_LOG(LogTemp, Display, TEXT("%s"), *Json);
+
+    FString OutputPath;
+    if (FParse::Value(*Params, TEXT("Output="), OutputPath) && !FFileHelper::SaveStringToFile(Json, *OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("AbilityStress: failed to write '%s'."), *OutputPath);
+        return 1;
+    }
+    return 0;
+}
+
+void UAbilityStressCommandlet::AddResult(const FString& Name, double Value, const FString& Unit)
+{
+    TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("suite"), TEXT("Stress"));
+    Result->SetStringField(TEXT("name"), Name);
+    Result->SetNumberField(TEXT("value"), Value);
+    Result->SetStringField(TEXT("unit"), Unit);
+    Results.Add(MakeShared<FJsonValueObject>(Result));
+
+    UE_LOG(LogTemp, Display, TEXT("Stress.%s = %.3f %s"), *Name, Value, *Unit);
+}
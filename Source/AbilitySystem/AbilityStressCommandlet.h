@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AbilityStressCommandlet.generated.h"
+
+/**
+ * Headless load test reproducing a production server population.
+ *
+ * Usage: -run=AbilityStress -nullrhi [-Actors=10000] [-Frames=900] [-FrameRate=30] [-Seed=1]
+ *        [-UnlockRate=0.01] [-UpgradeRate=0.01] [-AllocationRate=0.01] [-ActivationRate=0.2]
+ *        [-Output=Stress.json]
+ *
+ * Spawns the actors into a game world, each with a UAbilityComponent carrying every ability slot and
+ * a progression pool, then runs fixed-step frames. Each frame drives scripted unlock, upgrade,
+ * allocation and activation traffic (rates are events per actor per second; control activations
+ * also apply their effect to a random actor) and ticks the world, so timers, derived stats and the
+ * effect subsystem run as they do on a server. Reports frame time percentiles, traffic cost and the
+ * ability memory footprint using the AbilityBenchmark JSON schema.
+ */
+UCLASS()
+class UAbilityStressCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAbilityStressCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+
+    /** Record one named measurement in the report */
+    void AddResult(const FString& Name, double Value, const FString& Unit);
+
+    /** Collected measurements */
+    TArray<TSharedPtr<class FJsonValue>> Results;
+};
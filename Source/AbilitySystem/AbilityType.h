@@ -11,7 +11,8 @@ enum class ECombatAbility : uint8
     Melee       UMETA(DisplayName = "Melee"),
     Ranged      UMETA(DisplayName = "Ranged"),
     Charge      UMETA(DisplayName = "Charge"),
-    Overdrive   UMETA(DisplayName = "Overdrive")
+    Overdrive   UMETA(DisplayName = "Overdrive"),
+    Max         UMETA(Hidden)
 };
 
 /** Support and utility abilities */
@@ -22,7 +23,8 @@ enum class ESupportAbility : uint8
     Heal        UMETA(DisplayName = "Heal"),
     Shield      UMETA(DisplayName = "Shield"),
     Cleanse     UMETA(DisplayName = "Cleanse"),
-    Revive      UMETA(DisplayName = "Revive")
+    Revive      UMETA(DisplayName = "Revive"),
+    Max         UMETA(Hidden)
 };
 
 /** Movement and mobility abilities */
@@ -33,7 +35,8 @@ enum class EMovementAbility : uint8
     Dash        UMETA(DisplayName = "Dash"),
     Teleport    UMETA(DisplayName = "Teleport"),
     WallRun     UMETA(DisplayName = "WallRun"),
-    Grapple     UMETA(DisplayName = "Grapple")
+    Grapple     UMETA(DisplayName = "Grapple"),
+    Max         UMETA(Hidden)
 };
 
 /** Crowd control or elemental abilities */
@@ -44,9 +47,43 @@ enum class EControlAbility : uint8
     Stun        UMETA(DisplayName = "Stun"),
     Freeze      UMETA(DisplayName = "Freeze"),
     Burn        UMETA(DisplayName = "Burn"),
-    Slow        UMETA(DisplayName = "Slow")
+    Slow        UMETA(DisplayName = "Slow"),
+    Max         UMETA(Hidden)
 };
 
+/** Ability groups owned by UAbilityComponent */
+UENUM(BlueprintType)
+enum class EAbilityGroup : uint8
+{
+    Combat      UMETA(DisplayName = "Combat"),
+    Support     UMETA(DisplayName = "Support"),
+    Movement    UMETA(DisplayName = "Movement"),
+    Control     UMETA(DisplayName = "Control"),
+    Max         UMETA(Hidden)
+};
+
+/** Flat ability slot addressing: every group owns a fixed range of slots */
+namespace AbilitySlot
+{
+    /** Slots reserved per group */
+    constexpr int32 GroupStride = 8;
+
+    /** Total number of slots across all groups */
+    constexpr int32 Num = GroupStride * static_cast<int32>(EAbilityGroup::Max);
+
+    /** Flat slot index of an ability within its group */
+    constexpr int32 Index(EAbilityGroup Group, uint8 Ability)
+    {
+        return static_cast<int32>(Group) * GroupStride + Ability;
+    }
+}
+
+static_assert(static_cast<int32>(ECombatAbility::Max) <= AbilitySlot::GroupStride, "ECombatAbility exceeds its slot range");
+static_assert(static_cast<int32>(ESupportAbility::Max) <= AbilitySlot::GroupStride, "ESupportAbility exceeds its slot range");
+static_assert(static_cast<int32>(EMovementAbility::Max) <= AbilitySlot::GroupStride, "EMovementAbility exceeds its slot range");
+static_assert(static_cast<int32>(EControlAbility::Max) <= AbilitySlot::GroupStride, "EControlAbility exceeds its slot range");
+static_assert(AbilitySlot::Num <= 32, "Ability slots must fit a 32-bit mask");
+
 /** Ability data struct */
 USTRUCT(BlueprintType)
 struct FAbilityData
@@ -68,3 +105,56 @@ struct FAbilityData
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FString Description;
 };
+
+/** Compact runtime state of every ability slot, replicated in place of the ability maps */
+USTRUCT()
+struct FAbilityStateReplica
+{
+    GENERATED_BODY()
+
+    /** Unlock bit per flat ability slot */
+    UPROPERTY()
+    uint32 UnlockedMask = 0;
+
+    /** Level per flat ability slot */
+    UPROPERTY()
+    TArray<uint8> Levels;
+
+    /** Server world time at which each flat ability slot comes off cooldown; empty until the first cooldown */
+    UPROPERTY()
+    TArray<double> CooldownEndTimes;
+};
+
+/** All ability slot state in one struct, filled by UAbilityComponent::GetAbilitySnapshot */
+USTRUCT(BlueprintType)
+struct FAbilitySnapshot
+{
+    GENERATED_BODY()
+
+    /** Allocates storage for every slot once; refreshing the snapshot reuses it */
+    FAbilitySnapshot()
+    {
+        Levels.SetNumZeroed(AbilitySlot::Num);
+        CooldownRemaining.SetNumZeroed(AbilitySlot::Num);
+    }
+
+    /** Unlock bit per flat ability slot (see AbilitySlot) */
+    UPROPERTY(BlueprintReadOnly)
+    int32 UnlockedMask = 0;
+
+    /** Bit per flat ability slot that is unlocked and off cooldown */
+    UPROPERTY(BlueprintReadOnly)
+    int32 ReadyMask = 0;
+
+    /** Level per flat ability slot */
+    UPROPERTY(BlueprintReadOnly)
+    TArray<uint8> Levels;
+
+    /** Seconds of cooldown left per flat ability slot */
+    UPROPERTY(BlueprintReadOnly)
+    TArray<float> CooldownRemaining;
+
+    bool IsUnlocked(EAbilityGroup Group, uint8 Ability) const { return (UnlockedMask & (1 << AbilitySlot::Index(Group, Ability))) != 0; }
+
+    bool IsReady(EAbilityGroup Group, uint8 Ability) const { return (ReadyMask & (1 << AbilitySlot::Index(Group, Ability))) != 0; }
+};